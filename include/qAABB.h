@@ -0,0 +1,353 @@
+/*
+Copyright (c) 2022 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef __Q_AABB_H__
+#define __Q_AABB_H__
+
+#include "qCore.h"
+#include "qVector3.h"
+#include "qMatrix4.h"
+#include "qPacket.h"
+#include "qParallel.h"
+#include <math.h>
+#include <vector>
+#include <type_traits>
+
+//axis aligned box; the default box is empty (min +inf, max -inf), so expanding or merging into it needs no special case
+template<typename T, int ALIGN>
+class qAABB_T
+{
+public:
+	
+	typedef qVector3_T<T, ALIGN> Vector3;
+	
+	//the batch kernels walk points and boxes as flat arrays of T
+	static_assert(sizeof(Vector3) == 3 * sizeof(T), "qAABB_T needs tightly packed vectors");
+	
+	//points per slice below which the threaded build runs on the caller alone
+	static constexpr int ParallelSlice = 1 << 16;
+	
+	Vector3 min;
+	Vector3 max;
+	
+	constexpr qAABB_T()
+	: min(T(HUGE_VALF))
+	, max(T(-HUGE_VALF))
+	{}
+	
+	constexpr qAABB_T(const Vector3 &_min, const Vector3 &_max)
+	: min(_min)
+	, max(_max)
+	{}
+	
+	static qAABB_T FromCenter(const Vector3 &center, const Vector3 &extents)
+	{
+		return qAABB_T(center - extents, center + extents);
+	}
+	
+	static qAABB_T FromPoints(const Vector3* points, const int count)
+	{
+		qAABB_T box;
+		if(count > 0)
+		{
+			MinMaxKernel(points[0].v, count, box.min.v, box.max.v);
+		}
+		return box;
+	}
+	
+	//one box per slice of ParallelSlice points, merged at the end; equal to FromPoints(points, count)
+	static qAABB_T FromPoints(const Vector3* points, const int count, const int threads)
+	{
+		const int slices = (count + ParallelSlice - 1) / ParallelSlice;
+		if(slices <= 1 || threads == 1)
+		{
+			return FromPoints(points, count);
+		}
+		
+		std::vector<qAABB_T> boxes(slices);
+		qRunParallel(slices, [&](const int slice)
+		{
+			const int begin = slice * ParallelSlice;
+			boxes[slice] = FromPoints(points + begin, qMin(ParallelSlice, count - begin));
+		}, threads);
+		
+		qAABB_T box;
+		for(const qAABB_T &b : boxes)
+		{
+			box.Merge(b);
+		}
+		return box;
+	}
+	
+#pragma mark getters
+	
+	bool IsEmpty() const
+	{
+		return !(min.x <= max.x && min.y <= max.y && min.z <= max.z);
+	}
+	
+	Vector3 Center() const
+	{
+		return (min + max) * T(0.5);
+	}
+	
+	//half the size along each axis
+	Vector3 Extents() const
+	{
+		return (max - min) * T(0.5);
+	}
+	
+	Vector3 Size() const
+	{
+		return max - min;
+	}
+	
+	T SurfaceArea() const
+	{
+		Vector3 s = Size();
+		return T(2) * (s.x * s.y + s.y * s.z + s.z * s.x);
+	}
+	
+	T Volume() const
+	{
+		Vector3 s = Size();
+		return s.x * s.y * s.z;
+	}
+	
+#pragma mark setters
+	
+	void Expand(const Vector3 &point)
+	{
+		min = Vector3::Min(min, point);
+		max = Vector3::Max(max, point);
+	}
+	
+	void Expand(const Vector3* points, const int count)
+	{
+		if(count > 0)
+		{
+			MinMaxKernel(points[0].v, count, min.v, max.v);
+		}
+	}
+	
+	void Merge(const qAABB_T &box)
+	{
+		min = Vector3::Min(min, box.min);
+		max = Vector3::Max(max, box.max);
+	}
+	
+	static qAABB_T Merge(const qAABB_T &a, const qAABB_T &b)
+	{
+		return qAABB_T(Vector3::Min(a.min, b.min), Vector3::Max(a.max, b.max));
+	}
+	
+#pragma mark tests
+	
+	//boundaries count as inside, so touching boxes overlap
+	bool Contains(const Vector3 &point) const
+	{
+		return min.x <= point.x && point.x <= max.x &&
+			min.y <= point.y && point.y <= max.y &&
+			min.z <= point.z && point.z <= max.z;
+	}
+	
+	bool Contains(const qAABB_T &box) const
+	{
+		return min.x <= box.min.x && box.max.x <= max.x &&
+			min.y <= box.min.y && box.max.y <= max.y &&
+			min.z <= box.min.z && box.max.z <= max.z;
+	}
+	
+	bool Overlaps(const qAABB_T &box) const
+	{
+		return min.x <= box.max.x && box.min.x <= max.x &&
+			min.y <= box.max.y && box.min.y <= max.y &&
+			min.z <= box.max.z && box.min.z <= max.z;
+	}
+	
+	//out[i] = Overlaps(boxes[i])
+	void Overlaps(const qAABB_T* boxes, const int count, bool* out) const
+	{
+		OverlapKernel(min.v, max.v, boxes->min.v, count, out);
+	}
+	
+	//writes the indices of the overlapping boxes in order and returns how many there were; indices holds count
+	int Overlaps(const qAABB_T* boxes, const int count, int* indices) const
+	{
+		int found = 0;
+		for(int begin = 0; begin < count; begin += 256)
+		{
+			const int n = qMin(256, count - begin);
+			bool hits[256];
+			Overlaps(boxes + begin, n, hits);
+			for(int i = 0; i < n; ++i)
+			{
+				indices[found] = begin + i;
+				found += hits[i];
+			}
+		}
+		return found;
+	}
+	
+#pragma mark transform
+	
+	//Arvo's method in center/extents form: the center moves as a point, the extents through |M|
+	qAABB_T Transformed(const qMatrix4_T<T> &mat) const
+	{
+		if(IsEmpty())
+		{
+			return qAABB_T();
+		}
+		
+		const T* m = mat.m;
+		Vector3 c = Center();
+		Vector3 e = Extents();
+		Vector3 center, extents;
+		for(int i = 0; i < 3; ++i)
+		{
+			center.v[i] = m[i] * c.x + m[4 + i] * c.y + m[8 + i] * c.z + m[12 + i];
+			extents.v[i] = std::abs(m[i]) * e.x + std::abs(m[4 + i]) * e.y + std::abs(m[8 + i]) * e.z;
+		}
+		return FromCenter(center, extents);
+	}
+	
+	friend std::ostream& operator<<(std::ostream& out, const qAABB_T& box)
+	{
+		out << "aabb [min: " << box.min << ", max: " << box.max << "]";
+		return out;
+	}
+	
+private:
+	
+	//scalar reference kernels for any T, with float overloads that run on qFloatxN packets
+	
+	template<typename E>
+	static void MinMaxKernel(const E* in, const int count, E* lo, E* hi)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			for(int c = 0; c < 3; ++c)
+			{
+				lo[c] = qMin(lo[c], in[i * 3 + c]);
+				hi[c] = qMax(hi[c], in[i * 3 + c]);
+			}
+		}
+	}
+	
+	//boxes are min xyz then max xyz; a box overlaps when its mins are <= our max and its maxes >= our min
+	template<typename E>
+	static void OverlapKernel(const E* lo, const E* hi, const E* in, const int count, bool* out)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			const E* b = in + i * 6;
+			out[i] = (b[0] <= hi[0]) & (b[1] <= hi[1]) & (b[2] <= hi[2]) &
+				(b[3] >= lo[0]) & (b[4] >= lo[1]) & (b[5] >= lo[2]);
+		}
+	}
+	
+	//W points are 3 packets of the flat xyz stream, so lane l of packet k always holds axis (k * W + l) % 3 and the
+	//stream needs no transpose; the lanes fold onto their axis once at the end
+	static void MinMaxKernel(const float* in, const int count, float* lo, float* hi)
+	{
+		const int W = qPACKET_WIDTH;
+		const int packed = count - count % W;
+		if(packed > 0)
+		{
+			qFloatxN lo0(HUGE_VALF), lo1(HUGE_VALF), lo2(HUGE_VALF);
+			qFloatxN hi0(-HUGE_VALF), hi1(-HUGE_VALF), hi2(-HUGE_VALF);
+			for(int i = 0; i < packed * 3; i += W * 3)
+			{
+				qFloatxN a = qFloatxN::Load(in + i);
+				qFloatxN b = qFloatxN::Load(in + i + W);
+				qFloatxN c = qFloatxN::Load(in + i + W * 2);
+				lo0 = qFloatxN::Min(lo0, a);
+				hi0 = qFloatxN::Max(hi0, a);
+				lo1 = qFloatxN::Min(lo1, b);
+				hi1 = qFloatxN::Max(hi1, b);
+				lo2 = qFloatxN::Min(lo2, c);
+				hi2 = qFloatxN::Max(hi2, c);
+			}
+			
+			float los[W * 3], his[W * 3];
+			lo0.Store(los);
+			lo1.Store(los + W);
+			lo2.Store(los + W * 2);
+			hi0.Store(his);
+			hi1.Store(his + W);
+			hi2.Store(his + W * 2);
+			for(int l = 0; l < W * 3; ++l)
+			{
+				lo[l % 3] = qMin(lo[l % 3], los[l]);
+				hi[l % 3] = qMax(hi[l % 3], his[l]);
+			}
+		}
+		MinMaxKernel<float>(in + packed * 3, count - packed, lo, hi);
+	}
+	
+	//the same trick for boxes: W / 2 boxes are 3 packets, and scaling the max half of each box by -1 turns all six
+	//compares into <= against one pattern; a box overlaps when its six mask bits are all set
+	static void OverlapKernel(const float* lo, const float* hi, const float* in, const int count, bool* out)
+	{
+		const int W = qPACKET_WIDTH;
+		const int B = W / 2;
+		const int packed = count - count % B;
+		if(packed > 0)
+		{
+			float signs[W * 3], limits[W * 3];
+			for(int l = 0; l < W * 3; ++l)
+			{
+				const int c = l % 6;
+				signs[l] = c < 3 ? 1.0f : -1.0f;
+				limits[l] = c < 3 ? hi[c] : -lo[c - 3];
+			}
+			const qFloatxN s0 = qFloatxN::Load(signs), s1 = qFloatxN::Load(signs + W), s2 = qFloatxN::Load(signs + W * 2);
+			const qFloatxN l0 = qFloatxN::Load(limits), l1 = qFloatxN::Load(limits + W), l2 = qFloatxN::Load(limits + W * 2);
+			
+			for(int i = 0; i < packed; i += B)
+			{
+				const float* b = in + i * 6;
+				const uint32_t bits = uint32_t((qFloatxN::Load(b) * s0 <= l0).Bits()) |
+					(uint32_t((qFloatxN::Load(b + W) * s1 <= l1).Bits()) << W) |
+					(uint32_t((qFloatxN::Load(b + W * 2) * s2 <= l2).Bits()) << (W * 2));
+				for(int k = 0; k < B; ++k)
+				{
+					out[i + k] = ((bits >> (k * 6)) & 63) == 63;
+				}
+			}
+		}
+		OverlapKernel<float>(lo, hi, in + packed * 6, count - packed, out + packed);
+	}
+	
+} __attribute__ ((aligned (ALIGN)));
+
+typedef qAABB_T<double, 8> qAABBd;
+typedef qAABB_T<float, 4> qAABB;
+typedef qAABB_T<half, 2> qAABBh;
+
+static_assert(std::is_trivially_copyable<qAABBd>::value, "qAABBd must be trivially copyable");
+static_assert(std::is_standard_layout<qAABBd>::value, "qAABBd must be standard layout");
+static_assert(std::is_trivially_copyable<qAABB>::value, "qAABB must be trivially copyable");
+static_assert(std::is_standard_layout<qAABB>::value, "qAABB must be standard layout");
+static_assert(std::is_trivially_copyable<qAABBh>::value, "qAABBh must be trivially copyable");
+static_assert(std::is_standard_layout<qAABBh>::value, "qAABBh must be standard layout");
+
+#endif // __Q_AABB_H__
@@ -0,0 +1,344 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_AFFINE_H__
+#define __Q_AFFINE_H__
+
+#include <math.h>
+#include <type_traits>
+#include "qCore.h"
+#include "qVector3.h"
+#include "qMatrix3.h"
+#include "qMatrix4.h"
+#include <iostream>
+
+/*
+ column major like qMatrix4_T with the constant [ 0 0 0 1 ] row dropped
+ [ m00 m10 m20 m30 ]
+ [ m01 m11 m21 m31 ]
+ [ m02 m12 m22 m32 ]
+*/
+
+template<typename T>
+class qAffine3x4_T
+{
+public:
+	
+	typedef qVector3_T<T, sizeof(T)> Vector3;
+	
+	union
+	{
+		struct
+		{
+			T m00;
+			T m01;
+			T m02;
+			T m10;
+			T m11;
+			T m12;
+			T m20;
+			T m21;
+			T m22;
+			T m30;
+			T m31;
+			T m32;
+		};
+		T m[12];
+		T mm[4][3];
+	};
+	
+	constexpr qAffine3x4_T()
+	: m00(T(1))
+	, m01(T(0))
+	, m02(T(0))
+	, m10(T(0))
+	, m11(T(1))
+	, m12(T(0))
+	, m20(T(0))
+	, m21(T(0))
+	, m22(T(1))
+	, m30(T(0))
+	, m31(T(0))
+	, m32(T(0))
+	{}
+	
+	constexpr qAffine3x4_T(const T _m00, const T _m01, const T _m02,
+						   const T _m10, const T _m11, const T _m12,
+						   const T _m20, const T _m21, const T _m22,
+						   const T _m30, const T _m31, const T _m32)
+	: m00(_m00)
+	, m01(_m01)
+	, m02(_m02)
+	, m10(_m10)
+	, m11(_m11)
+	, m12(_m12)
+	, m20(_m20)
+	, m21(_m21)
+	, m22(_m22)
+	, m30(_m30)
+	, m31(_m31)
+	, m32(_m32)
+	{}
+	
+	//the last row of mat has to be [ 0 0 0 1 ]
+	explicit qAffine3x4_T(const qMatrix4_T<T> &mat)
+	: m00(mat.m00)
+	, m01(mat.m01)
+	, m02(mat.m02)
+	, m10(mat.m10)
+	, m11(mat.m11)
+	, m12(mat.m12)
+	, m20(mat.m20)
+	, m21(mat.m21)
+	, m22(mat.m22)
+	, m30(mat.m30)
+	, m31(mat.m31)
+	, m32(mat.m32)
+	{
+		qASSERTM(mat.m03 == T(0) && mat.m13 == T(0) && mat.m23 == T(0) && mat.m33 == T(1), "Converting a projective matrix to qAffine3x4_T");
+	}
+	
+	qMatrix4_T<T> ToMatrix4() const
+	{
+		return qMatrix4_T<T>(m00, m01, m02, T(0),
+							 m10, m11, m12, T(0),
+							 m20, m21, m22, T(0),
+							 m30, m31, m32, T(1));
+	}
+	
+#pragma mark getters
+	
+	T& operator[](int pos)
+	{
+		qASSERT(pos < 12);
+		return m[pos];
+	}
+	
+	T operator[](int pos) const
+	{
+		qASSERT(pos < 12);
+		return m[pos];
+	}
+	
+	Vector3 GetTranslation() const
+	{
+		return Vector3(m30, m31, m32);
+	}
+	
+	qMatrix3_T<T> GetLinear() const
+	{
+		return qMatrix3_T<T>(m00, m01, m02,
+							 m10, m11, m12,
+							 m20, m21, m22);
+	}
+	
+#pragma mark multiplication
+	
+	//applies rhs first, then this
+	qAffine3x4_T operator*(const qAffine3x4_T &rhs) const
+	{
+		qAffine3x4_T out;
+		MultiplyKernel(out.m, m, rhs.m);
+		return out;
+	}
+	
+	qAffine3x4_T& operator*=(const qAffine3x4_T &rhs)
+	{
+		qAffine3x4_T out;
+		MultiplyKernel(out.m, m, rhs.m);
+		(*this) = out;
+		return *this;
+	}
+	
+	Vector3 TransformPoint(const Vector3 &p) const
+	{
+		return Vector3((m00 * p.x) + (m10 * p.y) + (m20 * p.z) + m30,
+					   (m01 * p.x) + (m11 * p.y) + (m21 * p.z) + m31,
+					   (m02 * p.x) + (m12 * p.y) + (m22 * p.z) + m32);
+	}
+	
+	Vector3 TransformDirection(const Vector3 &d) const
+	{
+		return Vector3((m00 * d.x) + (m10 * d.y) + (m20 * d.z),
+					   (m01 * d.x) + (m11 * d.y) + (m21 * d.z),
+					   (m02 * d.x) + (m12 * d.y) + (m22 * d.z));
+	}
+	
+#pragma mark util
+	
+	static qAffine3x4_T Translate(const Vector3 &translate)
+	{
+		qAffine3x4_T out;
+		out.m30 = translate.x;
+		out.m31 = translate.y;
+		out.m32 = translate.z;
+		return out;
+	}
+	
+	static qAffine3x4_T Scale(const Vector3 &scale)
+	{
+		qAffine3x4_T out;
+		out.m00 = scale.x;
+		out.m11 = scale.y;
+		out.m22 = scale.z;
+		return out;
+	}
+	
+#pragma mark inverse
+	
+	T Determinant() const
+	{
+		return qAffine3x4_T::Determinant(*this);
+	}
+	
+	void Invert()
+	{
+		*this = qAffine3x4_T::Inverse(*this);
+	}
+	
+	static T Determinant(const qAffine3x4_T &mat)
+	{
+		return mat.m00 * ((mat.m11 * mat.m22) - (mat.m12 * mat.m21))
+			 - mat.m01 * ((mat.m10 * mat.m22) - (mat.m12 * mat.m20))
+			 + mat.m02 * ((mat.m10 * mat.m21) - (mat.m11 * mat.m20));
+	}
+	
+	//invert the 3x3 and carry the translation through it
+	static qAffine3x4_T Inverse(const qAffine3x4_T &mat)
+	{
+		qAffine3x4_T out;
+		T det = qMatrixAffineKernel<T, 3>::InverseLinear(out.m, mat.m);
+		qASSERT(det != T(0));
+		(void)det;
+		qMatrixAffineKernel<T, 3>::InverseTranslation(out.m, mat.m);
+		return out;
+	}
+	
+	//orthonormal rotation plus translation
+	static qAffine3x4_T InverseRigid(const qAffine3x4_T &mat)
+	{
+		qAffine3x4_T out;
+		qMatrixAffineKernel<T, 3>::InverseLinearOrthonormal(out.m, mat.m);
+		qMatrixAffineKernel<T, 3>::InverseTranslation(out.m, mat.m);
+		return out;
+	}
+	
+#pragma mark arrays
+	
+	//per element, out[i] = lhs[i] * rhs[i], e.g. parent world transforms times local transforms; out may alias either side
+	static void Multiply(const qAffine3x4_T* lhs, const qAffine3x4_T* rhs, qAffine3x4_T* out, const int count)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			T temp[12];
+			MultiplyKernel(temp, lhs[i].m, rhs[i].m);
+			for(int e = 0; e < 12; ++e)
+			{
+				out[i].m[e] = temp[e];
+			}
+		}
+	}
+	
+	//through qMatrix4_T's array kernels, which take the qSIMD paths for float; out may alias in
+	static void TransformPoints(const qAffine3x4_T &mat, const Vector3* in, Vector3* out, const int count)
+	{
+		qMatrix4_T<T>::TransformPoints(mat.ToMatrix4(), in, out, count);
+	}
+	
+	static void TransformDirections(const qAffine3x4_T &mat, const Vector3* in, Vector3* out, const int count)
+	{
+		qMatrix4_T<T>::TransformDirections(mat.ToMatrix4(), in, out, count);
+	}
+	
+	static void Inverse(const qAffine3x4_T* in, qAffine3x4_T* out, const int count)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			out[i] = Inverse(in[i]);
+		}
+	}
+	
+	static void InverseRigid(const qAffine3x4_T* in, qAffine3x4_T* out, const int count)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			out[i] = InverseRigid(in[i]);
+		}
+	}
+	
+	static void FromMatrix4(const qMatrix4_T<T>* in, qAffine3x4_T* out, const int count)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			out[i] = qAffine3x4_T(in[i]);
+		}
+	}
+	
+	static void ToMatrix4(const qAffine3x4_T* in, qMatrix4_T<T>* out, const int count)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			out[i] = in[i].ToMatrix4();
+		}
+	}
+	
+	friend std::ostream& operator<<(std::ostream& out, const qAffine3x4_T& mat)
+	{
+		out << "[" << mat.m00 << ", " << mat.m10 << ", " << mat.m20 << ", " << mat.m30 << "]" << std::endl;
+		out << "[" << mat.m01 << ", " << mat.m11 << ", " << mat.m21 << ", " << mat.m31 << "]" << std::endl;
+		out << "[" << mat.m02 << ", " << mat.m12 << ", " << mat.m22 << ", " << mat.m32 << "]" << std::endl;
+		return out;
+	}
+	
+private:
+	
+	//36 multiplies against 64 for the full 4x4 product; out must not alias lhs or rhs
+	static void MultiplyKernel(T* out, const T* lhs, const T* rhs)
+	{
+		for(int c = 0; c < 4; ++c)
+		{
+			for(int r = 0; r < 3; ++r)
+			{
+				out[c * 3 + r] = (lhs[r] * rhs[c * 3]) + (lhs[3 + r] * rhs[c * 3 + 1]) + (lhs[6 + r] * rhs[c * 3 + 2]);
+			}
+		}
+		
+		out[9] += lhs[9];
+		out[10] += lhs[10];
+		out[11] += lhs[11];
+	}
+};
+
+typedef qAffine3x4_T<double> qAffine3x4d;
+typedef qAffine3x4_T<float> qAffine3x4;
+typedef qAffine3x4_T<half> qAffine3x4h;
+
+static_assert(std::is_trivially_copyable<qAffine3x4d>::value, "qAffine3x4d must be trivially copyable");
+static_assert(std::is_trivially_copyable<qAffine3x4>::value, "qAffine3x4 must be trivially copyable");
+static_assert(std::is_trivially_copyable<qAffine3x4h>::value, "qAffine3x4h must be trivially copyable");
+static_assert(sizeof(qAffine3x4d) == 12 * sizeof(double), "qAffine3x4d must be tightly packed");
+static_assert(sizeof(qAffine3x4) == 12 * sizeof(float), "qAffine3x4 must be tightly packed");
+static_assert(sizeof(qAffine3x4h) == 12 * sizeof(half), "qAffine3x4h must be tightly packed");
+
+constexpr qAffine3x4 qAffine3x4_Identity;
+
+#endif // __Q_AFFINE_H__
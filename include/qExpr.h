@@ -0,0 +1,444 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_EXPR_H__
+#define __Q_EXPR_H__
+
+#include <math.h>
+#include <type_traits>
+#include "qCore.h"
+#include "qSIMD.h"
+#include "qVectorSoA.h"
+#include "qVector2.h"
+#include "qVector3.h"
+#include "qVector4.h"
+#include "qMatrix2.h"
+#include "qMatrix3.h"
+#include "qMatrix4.h"
+
+/*
+ opt-in lazy arithmetic for the vector and matrix types; include this header directly, qMath.h does not
+
+ qVector3 r = qLazy(a) * s + b - qLazy(c) * t;
+ (qLazy(m0) * 0.5f + qLazy(m1) * 0.5f).Evaluate(m);
+
+ the chain is evaluated once per element when it is assigned, with a * b + c fused into a multiply-add.
+ a sub-expression with no lazy operand, such as c * t above without qLazy, is still evaluated eagerly.
+ operands are held by reference, so an expression must be evaluated in the statement that builds it.
+ only element-wise operations are lazy; matrix products and transforms stay on the eager operators.
+*/
+
+//the node tree only pays off once it collapses into straight-line code, so nothing is left to the inliner's heuristics
+#define qEXPR_INLINE inline __attribute__ ((always_inline))
+
+#pragma mark traits
+
+//element type, element count and storage of each value type an expression can read or write
+template<typename V>
+struct qExprTraits
+{
+};
+
+template<typename T, int N, int ALIGN>
+struct qExprTraits<qVectorN_T<T, N, ALIGN> >
+{
+	typedef T Element;
+	enum { Size = N, Matrix = 0 };
+	static T* Data(qVectorN_T<T, N, ALIGN> &v)				{ return v.v; }
+	static const T* Data(const qVectorN_T<T, N, ALIGN> &v)	{ return v.v; }
+};
+
+template<typename T, int N, int M>
+struct qExprTraits<qMatrixNxM_T<T, N, M> >
+{
+	typedef T Element;
+	enum { Size = N * M, Matrix = 1 };
+	static T* Data(qMatrixNxM_T<T, N, M> &mat)				{ return mat.m; }
+	static const T* Data(const qMatrixNxM_T<T, N, M> &mat)	{ return mat.m; }
+};
+
+template<typename T>
+struct qExprVoid
+{
+	typedef void Type;
+};
+
+#pragma mark nodes
+
+//every node evaluates one element with Eval, and four float elements with Eval4 when SIMD is available;
+//Size is the element count of the node, or 0 for a scalar that broadcasts to any size, and Matrix marks nodes that read a matrix
+
+template<typename T>
+qEXPR_INLINE T qExprMulAdd(const T a, const T b, const T c)
+{
+	return (a * b) + c;
+}
+
+#if defined(__FMA__) || defined(__ARM_FEATURE_FMA)
+qEXPR_INLINE float qExprMulAdd(const float a, const float b, const float c)
+{
+	return fmaf(a, b, c);
+}
+
+qEXPR_INLINE double qExprMulAdd(const double a, const double b, const double c)
+{
+	return fma(a, b, c);
+}
+#endif
+
+template<typename V>
+struct qExprLeaf
+{
+	typedef qExprTraits<V> Traits;
+	typedef typename Traits::Element Element;
+	enum { Size = Traits::Size, Matrix = Traits::Matrix };
+	
+	const Element* p;
+	
+	qEXPR_INLINE explicit qExprLeaf(const V &v) : p(Traits::Data(v)) {}
+	
+	qEXPR_INLINE Element Eval(const int i) const				{ return p[i]; }
+#if qSIMD_ENABLED
+	qEXPR_INLINE qSIMD::float4 Eval4(const int i) const		{ return qSIMD::Load(p + i); }
+#endif
+};
+
+template<typename T>
+struct qExprScalar
+{
+	typedef T Element;
+	enum { Size = 0, Matrix = 0 };
+	
+	T s;
+	
+	qEXPR_INLINE explicit qExprScalar(const T _s) : s(_s) {}
+	
+	qEXPR_INLINE T Eval(const int) const						{ return s; }
+#if qSIMD_ENABLED
+	qEXPR_INLINE qSIMD::float4 Eval4(const int) const		{ return qSIMD::Splat(s); }
+#endif
+};
+
+template<typename OP, typename L, typename R>
+struct qExprBinary
+{
+	typedef typename L::Element Element;
+	enum { Size = (int)L::Size > (int)R::Size ? (int)L::Size : (int)R::Size, Matrix = (int)L::Matrix | (int)R::Matrix };
+	static_assert((int)L::Size == (int)R::Size || (int)L::Size == 0 || (int)R::Size == 0, "qExpr operands must have the same size");
+	
+	L l;
+	R r;
+	
+	qEXPR_INLINE qExprBinary(const L &_l, const R &_r) : l(_l), r(_r) {}
+	
+	qEXPR_INLINE Element Eval(const int i) const				{ return OP::Apply(l.Eval(i), r.Eval(i)); }
+#if qSIMD_ENABLED
+	qEXPR_INLINE qSIMD::float4 Eval4(const int i) const		{ return OP::Apply(l.Eval4(i), r.Eval4(i)); }
+#endif
+};
+
+template<typename A>
+struct qExprNegate
+{
+	typedef typename A::Element Element;
+	enum { Size = A::Size, Matrix = A::Matrix };
+	
+	A a;
+	
+	qEXPR_INLINE explicit qExprNegate(const A &_a) : a(_a) {}
+	
+	qEXPR_INLINE Element Eval(const int i) const				{ return -a.Eval(i); }
+#if qSIMD_ENABLED
+	qEXPR_INLINE qSIMD::float4 Eval4(const int i) const		{ return qSIMD::Mul(a.Eval4(i), qSIMD::Splat(-1.0f)); }
+#endif
+};
+
+//a * b + c in one rounding where the target has FMA
+template<typename A, typename B, typename C>
+struct qExprFused
+{
+	typedef typename A::Element Element;
+	typedef qExprBinary<qSoAOp_Add, qExprBinary<qSoAOp_Mul, A, B>, C> Shape;
+	enum { Size = Shape::Size, Matrix = Shape::Matrix };
+	
+	A a;
+	B b;
+	C c;
+	
+	qEXPR_INLINE qExprFused(const A &_a, const B &_b, const C &_c) : a(_a), b(_b), c(_c) {}
+	
+	qEXPR_INLINE Element Eval(const int i) const				{ return qExprMulAdd(a.Eval(i), b.Eval(i), c.Eval(i)); }
+#if qSIMD_ENABLED
+	qEXPR_INLINE qSIMD::float4 Eval4(const int i) const		{ return qSIMD::MulAdd(a.Eval4(i), b.Eval4(i), c.Eval4(i)); }
+#endif
+};
+
+#pragma mark evaluation
+
+//unrolled at compile time so the result and every operand can stay in registers;
+//while a whole register of floats remains, four elements are computed in full before they are stored, so out may alias any operand
+template<int I, int N, bool REGISTER = (I + 4 <= N)>
+struct qExprUnroll
+{
+	template<typename T, typename E>
+	qEXPR_INLINE static void Run(T* out, const E &e)
+	{
+		out[I] = e.Eval(I);
+		qExprUnroll<I + 1, N>::Run(out, e);
+	}
+};
+
+template<int I, int N>
+struct qExprUnroll<I, N, true>
+{
+	template<typename T, typename E>
+	qEXPR_INLINE static void Run(T* out, const E &e)
+	{
+		out[I] = e.Eval(I);
+		qExprUnroll<I + 1, N>::Run(out, e);
+	}
+	
+#if qSIMD_ENABLED
+	template<typename E>
+	qEXPR_INLINE static void Run(float* out, const E &e)
+	{
+		qSIMD::Store(out + I, e.Eval4(I));
+		qExprUnroll<I + 4, N>::Run(out, e);
+	}
+#endif
+};
+
+template<int N>
+struct qExprUnroll<N, N, false>
+{
+	template<typename T, typename E>
+	qEXPR_INLINE static void Run(T*, const E&)
+	{
+	}
+};
+
+template<typename E>
+class qExpr_T
+{
+public:
+	
+	typedef typename E::Element Element;
+	
+	E e;
+	
+	qEXPR_INLINE explicit qExpr_T(const E &_e)
+	: e(_e)
+	{}
+	
+	//writes straight into out, without constructing a result first
+	template<typename V>
+	qEXPR_INLINE void Evaluate(V &out) const
+	{
+		static_assert((int)qExprTraits<V>::Size == (int)E::Size, "qExpr result has a different size");
+		qExprUnroll<0, E::Size>::Run(qExprTraits<V>::Data(out), e);
+	}
+	
+	template<typename V, typename = typename qExprTraits<V>::Element>
+	qEXPR_INLINE operator V() const
+	{
+		V out;
+		Evaluate(out);
+		return out;
+	}
+	
+	qEXPR_INLINE qExpr_T<qExprNegate<E> > operator-() const
+	{
+		return qExpr_T<qExprNegate<E> >(qExprNegate<E>(e));
+	}
+};
+
+template<typename V>
+qEXPR_INLINE qExpr_T<qExprLeaf<V> > qLazy(const V &v)
+{
+	typedef qExprLeaf<V> Leaf;
+	return qExpr_T<Leaf>(Leaf(v));
+}
+
+#pragma mark operand mapping
+
+//element type of an operand that has one; scalars take theirs from the other side
+template<typename X, typename = void>
+struct qExprElement
+{
+};
+
+template<typename E>
+struct qExprElement<qExpr_T<E>, void>
+{
+	typedef typename E::Element Type;
+};
+
+template<typename V>
+struct qExprElement<V, typename qExprVoid<typename qExprTraits<V>::Element>::Type>
+{
+	typedef typename qExprTraits<V>::Element Type;
+};
+
+template<typename A, typename B, typename = void>
+struct qExprCommonElement : qExprElement<B>
+{
+};
+
+template<typename A, typename B>
+struct qExprCommonElement<A, B, typename qExprVoid<typename qExprElement<A>::Type>::Type> : qExprElement<A>
+{
+};
+
+//expressions, vector or matrix values, and scalars convertible to the element type
+template<typename X, typename ELEMENT, typename = void>
+struct qExprOperand
+{
+};
+
+template<typename E, typename ELEMENT>
+struct qExprOperand<qExpr_T<E>, ELEMENT, void>
+{
+	typedef E Node;
+	enum { Lazy = 1 };
+	qEXPR_INLINE static Node Get(const qExpr_T<E> &x) { return x.e; }
+};
+
+template<typename V, typename ELEMENT>
+struct qExprOperand<V, ELEMENT, typename qExprVoid<typename qExprTraits<V>::Element>::Type>
+{
+	typedef qExprLeaf<V> Node;
+	enum { Lazy = 0 };
+	qEXPR_INLINE static Node Get(const V &v) { return Node(v); }
+};
+
+template<typename S, typename ELEMENT>
+struct qExprOperand<S, ELEMENT, typename std::enable_if<!std::is_class<S>::value && std::is_convertible<S, ELEMENT>::value>::type>
+{
+	typedef qExprScalar<ELEMENT> Node;
+	enum { Lazy = 0 };
+	qEXPR_INLINE static Node Get(const S s) { return Node(ELEMENT(s)); }
+};
+
+#pragma mark fusion
+
+//builds the node for l OP r, folding a multiply feeding an add or subtract into a fused node
+template<typename OP, typename L, typename R>
+struct qExprMake
+{
+	static_assert(!(std::is_same<OP, qSoAOp_Mul>::value || std::is_same<OP, qSoAOp_Div>::value) || (int)L::Size == 0 || (int)R::Size == 0 || !((int)L::Matrix | (int)R::Matrix),
+				  "matrix products are not element-wise; use the eager qMatrix operators");
+	typedef qExprBinary<OP, L, R> Type;
+	qEXPR_INLINE static Type Make(const L &l, const R &r) { return Type(l, r); }
+};
+
+template<typename A, typename B, typename R>
+struct qExprMake<qSoAOp_Add, qExprBinary<qSoAOp_Mul, A, B>, R>
+{
+	typedef qExprFused<A, B, R> Type;
+	qEXPR_INLINE static Type Make(const qExprBinary<qSoAOp_Mul, A, B> &l, const R &r) { return Type(l.l, l.r, r); }
+};
+
+template<typename L, typename A, typename B>
+struct qExprMake<qSoAOp_Add, L, qExprBinary<qSoAOp_Mul, A, B> >
+{
+	typedef qExprFused<A, B, L> Type;
+	qEXPR_INLINE static Type Make(const L &l, const qExprBinary<qSoAOp_Mul, A, B> &r) { return Type(r.l, r.r, l); }
+};
+
+template<typename A, typename B, typename C, typename D>
+struct qExprMake<qSoAOp_Add, qExprBinary<qSoAOp_Mul, A, B>, qExprBinary<qSoAOp_Mul, C, D> >
+{
+	typedef qExprFused<A, B, qExprBinary<qSoAOp_Mul, C, D> > Type;
+	qEXPR_INLINE static Type Make(const qExprBinary<qSoAOp_Mul, A, B> &l, const qExprBinary<qSoAOp_Mul, C, D> &r) { return Type(l.l, l.r, r); }
+};
+
+template<typename A, typename B, typename R>
+struct qExprMake<qSoAOp_Sub, qExprBinary<qSoAOp_Mul, A, B>, R>
+{
+	typedef qExprFused<A, B, qExprNegate<R> > Type;
+	qEXPR_INLINE static Type Make(const qExprBinary<qSoAOp_Mul, A, B> &l, const R &r) { return Type(l.l, l.r, qExprNegate<R>(r)); }
+};
+
+template<typename L, typename A, typename B>
+struct qExprMake<qSoAOp_Sub, L, qExprBinary<qSoAOp_Mul, A, B> >
+{
+	typedef qExprFused<qExprNegate<A>, B, L> Type;
+	qEXPR_INLINE static Type Make(const L &l, const qExprBinary<qSoAOp_Mul, A, B> &r) { return Type(qExprNegate<A>(r.l), r.r, l); }
+};
+
+template<typename A, typename B, typename C, typename D>
+struct qExprMake<qSoAOp_Sub, qExprBinary<qSoAOp_Mul, A, B>, qExprBinary<qSoAOp_Mul, C, D> >
+{
+	typedef qExprFused<A, B, qExprNegate<qExprBinary<qSoAOp_Mul, C, D> > > Type;
+	qEXPR_INLINE static Type Make(const qExprBinary<qSoAOp_Mul, A, B> &l, const qExprBinary<qSoAOp_Mul, C, D> &r) { return Type(l.l, l.r, qExprNegate<qExprBinary<qSoAOp_Mul, C, D> >(r)); }
+};
+
+//only exists when at least one side is already lazy, so the eager operators are never shadowed
+template<typename OP, typename A, typename B, typename = void>
+struct qExprResult
+{
+};
+
+template<typename OP, typename A, typename B>
+struct qExprResult<OP, A, B, typename std::enable_if<
+	(int)qExprOperand<A, typename qExprCommonElement<A, B>::Type>::Lazy ||
+	(int)qExprOperand<B, typename qExprCommonElement<A, B>::Type>::Lazy>::type>
+{
+	typedef typename qExprCommonElement<A, B>::Type Element;
+	typedef qExprOperand<A, Element> LA;
+	typedef qExprOperand<B, Element> LB;
+	typedef qExprMake<OP, typename LA::Node, typename LB::Node> Maker;
+	typedef qExpr_T<typename Maker::Type> Type;
+	
+	qEXPR_INLINE static Type Make(const A &a, const B &b)
+	{
+		return Type(Maker::Make(LA::Get(a), LB::Get(b)));
+	}
+};
+
+#pragma mark operators
+
+template<typename A, typename B>
+qEXPR_INLINE typename qExprResult<qSoAOp_Add, A, B>::Type operator+(const A &a, const B &b)
+{
+	return qExprResult<qSoAOp_Add, A, B>::Make(a, b);
+}
+
+template<typename A, typename B>
+qEXPR_INLINE typename qExprResult<qSoAOp_Sub, A, B>::Type operator-(const A &a, const B &b)
+{
+	return qExprResult<qSoAOp_Sub, A, B>::Make(a, b);
+}
+
+template<typename A, typename B>
+qEXPR_INLINE typename qExprResult<qSoAOp_Mul, A, B>::Type operator*(const A &a, const B &b)
+{
+	return qExprResult<qSoAOp_Mul, A, B>::Make(a, b);
+}
+
+template<typename A, typename B>
+qEXPR_INLINE typename qExprResult<qSoAOp_Div, A, B>::Type operator/(const A &a, const B &b)
+{
+	return qExprResult<qSoAOp_Div, A, B>::Make(a, b);
+}
+
+#endif // __Q_EXPR_H__
@@ -0,0 +1,317 @@
+/*
+Copyright (c) 2022 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef __Q_FRUSTUM_H__
+#define __Q_FRUSTUM_H__
+
+#include "qCore.h"
+#include "qVector3.h"
+#include "qMatrix4.h"
+#include "qPlane.h"
+#include "qAABB.h"
+#include "qVectorSoA.h"
+#include "qPacket.h"
+#include <stdint.h>
+#include <math.h>
+#include <type_traits>
+
+//six inward facing planes; a point is inside when its signed distance to every plane is >= 0
+template<typename T, int ALIGN>
+class qFrustum_T
+{
+public:
+	
+	typedef qVector3_T<T, ALIGN> Vector3;
+	typedef qPlane_T<T, ALIGN> Plane;
+	
+	enum Side
+	{
+		eSide_Outside,
+		eSide_Intersect,
+		eSide_Inside,
+	};
+	
+	enum PlaneIndex
+	{
+		ePlane_Left,
+		ePlane_Right,
+		ePlane_Bottom,
+		ePlane_Top,
+		ePlane_Near,
+		ePlane_Far,
+		ePlane_Count,
+	};
+	
+	Plane planes[ePlane_Count];
+	
+	//Gribb and Hartmann: with column vectors each plane is row 3 plus or minus row 0, 1 or 2 of the view-projection;
+	//clip depth is 0..w as qCamera::Perspective and Orthographic produce, so the near plane is row 2 alone
+	qFrustum_T(const qMatrix4_T<T> &viewProjection)
+	: planes
+	{
+		Extract(viewProjection, 0, T(1)),
+		Extract(viewProjection, 0, T(-1)),
+		Extract(viewProjection, 1, T(1)),
+		Extract(viewProjection, 1, T(-1)),
+		Extract(viewProjection, 2, T(1), T(0)),
+		Extract(viewProjection, 2, T(-1)),
+	}
+	{}
+	
+#pragma mark tests
+	
+	bool Contains(const Vector3 &point) const
+	{
+		for(const Plane &plane : planes)
+		{
+			if(plane.SignedDistance(point) < T(0))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	
+	//a sphere only needs its nearest plane: outside when that distance is below -radius, inside when it is >= radius
+	Side Classify(const Vector3 &center, const T radius) const
+	{
+		T nearest = planes[0].SignedDistance(center);
+		for(int p = 1; p < ePlane_Count; ++p)
+		{
+			nearest = qMin(nearest, planes[p].SignedDistance(center));
+		}
+		return Resolve(nearest < -radius, nearest < radius);
+	}
+	
+	//a box projects onto each normal as center distance plus or minus |n| . extents
+	Side Classify(const qAABB_T<T, ALIGN> &box) const
+	{
+		const Vector3 center = box.Center();
+		const Vector3 extents = box.Extents();
+		bool outside = false, intersect = false;
+		for(const Plane &plane : planes)
+		{
+			T distance = plane.SignedDistance(center);
+			T radius = Vector3::Dot(Vector3::Abs(plane.normal), extents);
+			outside |= distance < -radius;
+			intersect |= distance < radius;
+		}
+		return Resolve(outside, intersect);
+	}
+	
+#pragma mark batch
+	
+	//out[i] is a Side for sphere i; x, y, z and radius are parallel arrays
+	void ClassifySpheres(const T* x, const T* y, const T* z, const T* radius, const int count, uint8_t* out) const
+	{
+		T coefficients[ePlane_Count * 4];
+		Coefficients(coefficients);
+		SphereKernel(coefficients, x, y, z, radius, count, out);
+	}
+	
+	void ClassifySpheres(const qVectorSoA_T<T, 3> &centers, const qVectorSoA_T<T, 1> &radii, uint8_t* out) const
+	{
+		qASSERT(centers.Count() == radii.Count());
+		ClassifySpheres(centers.Stream(0), centers.Stream(1), centers.Stream(2), radii.Stream(0), centers.Count(), out);
+	}
+	
+	//out[i] is a Side for box i, given as parallel arrays of its min and max corners
+	void ClassifyBoxes(const T* minX, const T* minY, const T* minZ, const T* maxX, const T* maxY, const T* maxZ, const int count, uint8_t* out) const
+	{
+		T coefficients[ePlane_Count * 4];
+		Coefficients(coefficients);
+		const T* const bounds[6] = { minX, minY, minZ, maxX, maxY, maxZ };
+		BoxKernel(coefficients, bounds, count, out);
+	}
+	
+	void ClassifyBoxes(const qVectorSoA_T<T, 3> &mins, const qVectorSoA_T<T, 3> &maxs, uint8_t* out) const
+	{
+		qASSERT(mins.Count() == maxs.Count());
+		ClassifyBoxes(mins.Stream(0), mins.Stream(1), mins.Stream(2), maxs.Stream(0), maxs.Stream(1), maxs.Stream(2), mins.Count(), out);
+	}
+	
+	friend std::ostream& operator<<(std::ostream& out, const qFrustum_T& frustum)
+	{
+		out << "frustum [";
+		for(const Plane &plane : frustum.planes)
+		{
+			out << " (" << plane.normal << ", " << plane.d << ")";
+		}
+		out << " ]";
+		return out;
+	}
+	
+private:
+	
+	//w * row 3 + sign * row
+	static Plane Extract(const qMatrix4_T<T> &mat, const int row, const T sign, const T w = T(1))
+	{
+		const T* m = mat.m;
+		return Plane::FromCoefficients(w * m[3] + sign * m[row],
+									   w * m[7] + sign * m[4 + row],
+									   w * m[11] + sign * m[8 + row],
+									   w * m[15] + sign * m[12 + row]);
+	}
+	
+	static Side Resolve(const bool outside, const bool intersect)
+	{
+		return Side(int(eSide_Inside) - int(outside) - int(intersect));
+	}
+	
+	//nx, ny, nz, d per plane
+	void Coefficients(T* out) const
+	{
+		for(int p = 0; p < ePlane_Count; ++p)
+		{
+			out[p * 4 + 0] = planes[p].normal.x;
+			out[p * 4 + 1] = planes[p].normal.y;
+			out[p * 4 + 2] = planes[p].normal.z;
+			out[p * 4 + 3] = planes[p].d;
+		}
+	}
+	
+	//scalar reference kernels for any T, with float overloads that run eight objects per iteration on qFloatxN packets
+	
+	template<typename E>
+	static void SphereKernel(const E* planes, const E* x, const E* y, const E* z, const E* radius, const int count, uint8_t* out)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			E nearest = planes[0] * x[i] + planes[1] * y[i] + planes[2] * z[i] + planes[3];
+			for(int p = 1; p < ePlane_Count; ++p)
+			{
+				const E* n = planes + p * 4;
+				nearest = qMin(nearest, n[0] * x[i] + n[1] * y[i] + n[2] * z[i] + n[3]);
+			}
+			out[i] = uint8_t(Resolve(nearest < -radius[i], nearest < radius[i]));
+		}
+	}
+	
+	//outside when any plane has distance + radius < 0, crossing when any has distance - radius < 0
+	template<typename E>
+	static void BoxKernel(const E* planes, const E* const* bounds, const int count, uint8_t* out)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			E c[3], e[3];
+			for(int k = 0; k < 3; ++k)
+			{
+				c[k] = (bounds[k][i] + bounds[k + 3][i]) * E(0.5);
+				e[k] = (bounds[k + 3][i] - bounds[k][i]) * E(0.5);
+			}
+			
+			bool outside = false, intersect = false;
+			for(int p = 0; p < ePlane_Count; ++p)
+			{
+				const E* n = planes + p * 4;
+				E distance = n[0] * c[0] + n[1] * c[1] + n[2] * c[2] + n[3];
+				E r = std::abs(n[0]) * e[0] + std::abs(n[1]) * e[1] + std::abs(n[2]) * e[2];
+				outside |= distance < -r;
+				intersect |= distance < r;
+			}
+			out[i] = uint8_t(Resolve(outside, intersect));
+		}
+	}
+	
+	//lane l of the two masks becomes Inside - outside - intersect, the same sum Resolve takes
+	static void StoreSides(const int outside, const int intersect, const int lanes, uint8_t* out)
+	{
+		for(int l = 0; l < lanes; ++l)
+		{
+			out[l] = uint8_t(int(eSide_Inside) - ((outside >> l) & 1) - ((intersect >> l) & 1));
+		}
+	}
+	
+	static void SphereKernel(const float* planes, const float* x, const float* y, const float* z, const float* radius, const int count, uint8_t* out)
+	{
+		const int W = qPACKET_WIDTH;
+		const int packed = count - count % 8;
+		for(int i = 0; i < packed; i += 8)
+		{
+			for(int j = i; j < i + 8; j += W)
+			{
+				const qFloatxN cx = qFloatxN::Load(x + j);
+				const qFloatxN cy = qFloatxN::Load(y + j);
+				const qFloatxN cz = qFloatxN::Load(z + j);
+				const qFloatxN r = qFloatxN::Load(radius + j);
+				
+				qFloatxN nearest(HUGE_VALF);
+				for(int p = 0; p < ePlane_Count; ++p)
+				{
+					const float* n = planes + p * 4;
+					qFloatxN distance = qFloatxN::MulAdd(cx, n[0], qFloatxN::MulAdd(cy, n[1], qFloatxN::MulAdd(cz, n[2], n[3])));
+					nearest = qFloatxN::Min(nearest, distance);
+				}
+				StoreSides((nearest < -r).Bits(), (nearest < r).Bits(), W, out + j);
+			}
+		}
+		SphereKernel<float>(planes, x + packed, y + packed, z + packed, radius + packed, count - packed, out + packed);
+	}
+	
+	static void BoxKernel(const float* planes, const float* const* bounds, const int count, uint8_t* out)
+	{
+		const int W = qPACKET_WIDTH;
+		const int packed = count - count % 8;
+		for(int i = 0; i < packed; i += 8)
+		{
+			for(int j = i; j < i + 8; j += W)
+			{
+				qFloatxN c[3], e[3];
+				for(int k = 0; k < 3; ++k)
+				{
+					const qFloatxN lo = qFloatxN::Load(bounds[k] + j);
+					const qFloatxN hi = qFloatxN::Load(bounds[k + 3] + j);
+					c[k] = (lo + hi) * 0.5f;
+					e[k] = (hi - lo) * 0.5f;
+				}
+				
+				//nearest reach of the box past each plane, and of its center less the extent
+				qFloatxN outer(HUGE_VALF), inner(HUGE_VALF);
+				for(int p = 0; p < ePlane_Count; ++p)
+				{
+					const float* n = planes + p * 4;
+					qFloatxN distance = qFloatxN::MulAdd(c[0], n[0], qFloatxN::MulAdd(c[1], n[1], qFloatxN::MulAdd(c[2], n[2], n[3])));
+					qFloatxN r = qFloatxN::MulAdd(e[0], fabsf(n[0]), qFloatxN::MulAdd(e[1], fabsf(n[1]), e[2] * fabsf(n[2])));
+					outer = qFloatxN::Min(outer, distance + r);
+					inner = qFloatxN::Min(inner, distance - r);
+				}
+				StoreSides((outer < 0.0f).Bits(), (inner < 0.0f).Bits(), W, out + j);
+			}
+		}
+		
+		const float* const rest[6] = { bounds[0] + packed, bounds[1] + packed, bounds[2] + packed, bounds[3] + packed, bounds[4] + packed, bounds[5] + packed };
+		BoxKernel<float>(planes, rest, count - packed, out + packed);
+	}
+	
+} __attribute__ ((aligned (ALIGN)));
+
+typedef qFrustum_T<double, 8> qFrustumd;
+typedef qFrustum_T<float, 4> qFrustum;
+typedef qFrustum_T<half, 2> qFrustumh;
+
+static_assert(std::is_trivially_copyable<qFrustumd>::value, "qFrustumd must be trivially copyable");
+static_assert(std::is_standard_layout<qFrustumd>::value, "qFrustumd must be standard layout");
+static_assert(std::is_trivially_copyable<qFrustum>::value, "qFrustum must be trivially copyable");
+static_assert(std::is_standard_layout<qFrustum>::value, "qFrustum must be standard layout");
+static_assert(std::is_trivially_copyable<qFrustumh>::value, "qFrustumh must be trivially copyable");
+static_assert(std::is_standard_layout<qFrustumh>::value, "qFrustumh must be standard layout");
+
+#endif // __Q_FRUSTUM_H__
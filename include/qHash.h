@@ -0,0 +1,210 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_HASH_H__
+#define __Q_HASH_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ wyhash (final version): 64 bit multiply-xor mixing over 48 byte steps split across three independent lanes, with
+ overlapping 4 and 8 byte reads for the tail, so no key is ever read a byte at a time. not cryptographic, and not
+ resistant to deliberately chosen collisions. qHash in qUtil.h is the low and high halves of this folded together.
+ the core is constexpr and reads through a KEY object, so qHash64 and qHash64Constexpr share every step but the loads.
+*/
+
+struct qWyHash
+{
+	static constexpr uint64_t Secret[4] = { 0x2D358DCCAA6C78A5ull, 0x8BB84B93962EACC9ull, 0x4B33A62ED433D4A3ull, 0x4D5A2DA51DE1AA47ull };
+	
+	//the 128 bit product of a and b, low half into a and high half into b
+	static constexpr void Multiply(uint64_t &a, uint64_t &b)
+	{
+#if defined(__SIZEOF_INT128__)
+		const __uint128_t product = __uint128_t(a) * b;
+		a = uint64_t(product);
+		b = uint64_t(product >> 64);
+#else
+		const uint64_t ha = a >> 32, hb = b >> 32, la = uint32_t(a), lb = uint32_t(b);
+		const uint64_t hh = ha * hb, hl = ha * lb, lh = la * hb, ll = la * lb;
+		const uint64_t t = ll + (hl << 32);
+		uint64_t carry = t < ll;
+		const uint64_t lo = t + (lh << 32);
+		carry += lo < t;
+		a = lo;
+		b = hh + (hl >> 32) + (lh >> 32) + carry;
+#endif
+	}
+	
+	static constexpr uint64_t Mix(uint64_t a, uint64_t b)
+	{
+		Multiply(a, b);
+		return a ^ b;
+	}
+	
+	static constexpr uint64_t Seed(const uint64_t seed)
+	{
+		return seed ^ Mix(seed ^ Secret[0], Secret[1]);
+	}
+	
+	//keys of 16 bytes or less, read as two overlapping pairs of words
+	template<typename KEY>
+	static constexpr void Short(const KEY &key, const size_t length, uint64_t &a, uint64_t &b)
+	{
+		if(length >= 4)
+		{
+			const size_t step = (length >> 3) << 2;
+			a = (key.Read4(0) << 32) | key.Read4(step);
+			b = (key.Read4(length - 4) << 32) | key.Read4(length - 4 - step);
+		}
+		else if(length > 0)
+		{
+			a = (key.Byte(0) << 16) | (key.Byte(length >> 1) << 8) | key.Byte(length - 1);
+			b = 0;
+		}
+		else
+		{
+			a = b = 0;
+		}
+	}
+	
+	static constexpr uint64_t Final(uint64_t a, uint64_t b, const uint64_t seed, const uint64_t length)
+	{
+		a ^= Secret[1];
+		b ^= seed;
+		Multiply(a, b);
+		return Mix(a ^ Secret[0] ^ length, b ^ Secret[1]);
+	}
+	
+	template<typename KEY>
+	static constexpr uint64_t Hash(const KEY &key, const size_t length, uint64_t seed)
+	{
+		seed = Seed(seed);
+		uint64_t a = 0, b = 0;
+		if(length <= 16)
+		{
+			Short(key, length, a, b);
+		}
+		else
+		{
+			size_t p = 0;
+			size_t i = length;
+			if(i >= 48)
+			{
+				uint64_t see1 = seed, see2 = seed;
+				do
+				{
+					seed = Mix(key.Read8(p) ^ Secret[1], key.Read8(p + 8) ^ seed);
+					see1 = Mix(key.Read8(p + 16) ^ Secret[2], key.Read8(p + 24) ^ see1);
+					see2 = Mix(key.Read8(p + 32) ^ Secret[3], key.Read8(p + 40) ^ see2);
+					p += 48;
+					i -= 48;
+				}
+				while(i >= 48);
+				seed ^= see1 ^ see2;
+			}
+			while(i > 16)
+			{
+				seed = Mix(key.Read8(p) ^ Secret[1], key.Read8(p + 8) ^ seed);
+				p += 16;
+				i -= 16;
+			}
+			a = key.Read8(p + i - 16);
+			b = key.Read8(p + i - 8);
+		}
+		return Final(a, b, seed, length);
+	}
+	
+	//little endian words assembled from chars, which constant expressions can read
+	struct Chars
+	{
+		const char* p;
+		
+		constexpr uint64_t Byte(const size_t i) const
+		{
+			return uint8_t(p[i]);
+		}
+		
+		constexpr uint64_t Read4(const size_t i) const
+		{
+			return Byte(i) | (Byte(i + 1) << 8) | (Byte(i + 2) << 16) | (Byte(i + 3) << 24);
+		}
+		
+		constexpr uint64_t Read8(const size_t i) const
+		{
+			return Read4(i) | (Read4(i + 4) << 32);
+		}
+	};
+};
+
+uint64_t qHash64(const void* key, const size_t length, const uint64_t seed = 0);
+
+//qHash64's values in constant expressions; a byte at a time, so at run time qHash64 is the one to call
+constexpr uint64_t qHash64Constexpr(const char* key, const size_t length, const uint64_t seed = 0)
+{
+	return qWyHash::Hash(qWyHash::Chars{ key }, length, seed);
+}
+
+//true while the compiler is evaluating a constant expression; without the builtin, constexpr callers always take the
+//constant expression path, which gives the same values more slowly
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define qHASH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+#ifndef qHASH_CONSTANT_EVALUATED
+#define qHASH_CONSTANT_EVALUATED() true
+#endif
+
+//the same values as qHash64 over the concatenation of everything passed to Update, for data that arrives in pieces.
+//Finish doesn't change the state, so a stream can be finished, extended and finished again
+class qHashStream
+{
+public:
+	
+	explicit qHashStream(const uint64_t _seed = 0)
+	{
+		Reset(_seed);
+	}
+	
+	void Reset(const uint64_t _seed = 0);
+	void Update(const void* data, const size_t length);
+	uint64_t Finish() const;
+	
+private:
+	
+	static const int Block = 48;
+	static const int Tail = 16;
+	
+	uint64_t lane[3];
+	uint64_t seed;
+	uint64_t total;
+	int buffered;
+	
+	//the last Tail bytes already mixed in, then the unmixed bytes, so the final reads can reach back across a block
+	uint8_t buffer[Tail + Block];
+	
+	void Block48(const uint8_t* p);
+};
+
+#endif //__Q_HASH_H__
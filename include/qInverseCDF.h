@@ -0,0 +1,78 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_INVERSE_CDF_H__
+#define __Q_INVERSE_CDF_H__
+
+#include "qCore.h"
+#include "qUtil.h"
+#include "qRandomEngine.h"
+
+/*
+ a distribution on [0, 1] kept as its inverse cdf, sampled at Size + 1 evenly spaced probabilities. a draw is one random
+ float and one interpolated lookup, whatever the shape. tables are built from density samples, so any curve an artist
+ can draw works; the built in shapes are built on first use and live for the program.
+*/
+
+class qInverseCDF
+{
+public:
+	
+	static const int Size = 256;
+	
+	float table[Size + 1];
+	
+	//count density samples evenly spaced over [0, 1], the first at 0 and the last at 1, linear between them.
+	//needs at least two samples, none negative, and some area under them
+	qInverseCDF(const float* density, const int count);
+	
+	//[0, 1) in, [0, 1) out; the largest float below 1 stands in for 1 so int ranges stay exclusive of max
+	float Map(const float unit) const
+	{
+		const float position = unit * float(Size);
+		const int index = qMin(int(position), Size - 1);
+		const float a = table[index];
+		const float b = table[index + 1];
+		return qMin(a + (b - a) * (position - float(index)), 0.99999994f);
+	}
+	
+	float Sample(qRandomEngine &engine) const
+	{
+		return Map(engine.NextFloat());
+	}
+	
+	void Fill(qRandomEngine &engine, float* out, const int count) const;
+	
+	//exp(-5x), a mean of about 0.19
+	static const qInverseCDF& Exponential();
+	
+	//peaked at 0.5, falling linearly to 0 at either end
+	static const qInverseCDF& Triangular();
+	
+	//log-normal with a median of 0.25 and a sigma of 0.5, cut off at 1
+	static const qInverseCDF& LogNormal();
+	
+	//one shared table per distinct set of samples, kept for the life of the program; for curves read from data files
+	static const qInverseCDF* Intern(const float* density, const int count);
+};
+
+#endif //__Q_INVERSE_CDF_H__
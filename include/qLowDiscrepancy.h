@@ -0,0 +1,472 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_LOW_DISCREPANCY_H__
+#define __Q_LOW_DISCREPANCY_H__
+
+#include <stdint.h>
+#include "qCore.h"
+#include "qVector2.h"
+#include "qVector3.h"
+#include "qRandomEngine.h"
+
+/*
+ quasi random points in [0, 1)^2 and [0, 1)^3; they cover the domain far more evenly than qRandom's white noise, so
+ integrals such as AO or soft shadows converge with fewer samples. every sequence is random access through
+ Sample(index, dimension), Sample2 and Sample3; Fill writes consecutive indices. a nonzero seed scrambles the sequence,
+ so different seeds give decorrelated point sets with the same evenness.
+*/
+
+//shared Sample2, Sample3 and Fill over the derived class's Sample(index, dimension)
+template<class DERIVED, typename T>
+class qSequence_T
+{
+public:
+	
+	typedef qVector2_T<T, sizeof(T)> Vector2;
+	typedef qVector3_T<T, sizeof(T)> Vector3;
+	
+	Vector2 Sample2(const uint32_t index) const
+	{
+		const DERIVED& self = static_cast<const DERIVED&>(*this);
+		return Vector2(self.Sample(index, 0), self.Sample(index, 1));
+	}
+	
+	Vector3 Sample3(const uint32_t index) const
+	{
+		const DERIVED& self = static_cast<const DERIVED&>(*this);
+		return Vector3(self.Sample(index, 0), self.Sample(index, 1), self.Sample(index, 2));
+	}
+	
+	void Fill(const uint32_t firstIndex, Vector2* out, const int count) const
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			out[i] = static_cast<const DERIVED&>(*this).Sample2(firstIndex + uint32_t(i));
+		}
+	}
+	
+	void Fill(const uint32_t firstIndex, Vector3* out, const int count) const
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			out[i] = static_cast<const DERIVED&>(*this).Sample3(firstIndex + uint32_t(i));
+		}
+	}
+	
+protected:
+	
+	//[0, 1) from the top 24 bits of a 32 bit fraction
+	static T ToUnit(const uint32_t bits)
+	{
+		return T(bits >> 8) * T(1.0 / 16777216.0);
+	}
+	
+	static uint32_t ReverseBits(uint32_t x)
+	{
+		x = (x << 16) | (x >> 16);
+		x = ((x & 0x00FF00FFu) << 8) | ((x & 0xFF00FF00u) >> 8);
+		x = ((x & 0x0F0F0F0Fu) << 4) | ((x & 0xF0F0F0F0u) >> 4);
+		x = ((x & 0x33333333u) << 2) | ((x & 0xCCCCCCCCu) >> 2);
+		x = ((x & 0x55555555u) << 1) | ((x & 0xAAAAAAAAu) >> 1);
+		return x;
+	}
+};
+
+#pragma mark Halton
+
+//bases 2, 3 and 5. scrambling adds a random offset, mod the base, to each digit level of the radical inverse
+template<typename T>
+class qHalton_T : public qSequence_T<qHalton_T<T>, T>
+{
+	typedef qSequence_T<qHalton_T<T>, T> Base;
+	
+public:
+	
+	//enough digits to cover every 32 bit index in bases 3 and 5
+	static const int Digits3 = 21;
+	static const int Digits5 = 14;
+	
+	explicit qHalton_T(const uint32_t seed = 0)
+	{
+		mask2 = 0;
+		for(int i = 0; i < Digits3; ++i)
+		{
+			offset3[i] = 0;
+		}
+		for(int i = 0; i < Digits5; ++i)
+		{
+			offset5[i] = 0;
+		}
+		
+		if(seed != 0)
+		{
+			qRandomEngine engine(seed);
+			mask2 = engine.Next32();
+			for(int i = 0; i < Digits3; ++i)
+			{
+				offset3[i] = uint8_t(engine.NextBounded(3));
+			}
+			for(int i = 0; i < Digits5; ++i)
+			{
+				offset5[i] = uint8_t(engine.NextBounded(5));
+			}
+		}
+	}
+	
+	T Sample(const uint32_t index, const int dimension) const
+	{
+		qASSERT(dimension >= 0 && dimension < 3);
+		switch(dimension)
+		{
+			case 0: return Base::ToUnit(Base::ReverseBits(index) ^ mask2);
+			case 1: return RadicalInverse<3, Digits3>(index, offset3);
+			default: return RadicalInverse<5, Digits5>(index, offset5);
+		}
+	}
+	
+	void Fill(const uint32_t firstIndex, typename Base::Vector2* out, const int count) const
+	{
+		Walker<3, Digits3> y(firstIndex, offset3);
+		for(int i = 0; i < count; ++i, y.Step())
+		{
+			out[i] = typename Base::Vector2(Sample(firstIndex + uint32_t(i), 0), y.Value());
+		}
+	}
+	
+	void Fill(const uint32_t firstIndex, typename Base::Vector3* out, const int count) const
+	{
+		Walker<3, Digits3> y(firstIndex, offset3);
+		Walker<5, Digits5> z(firstIndex, offset5);
+		for(int i = 0; i < count; ++i, y.Step(), z.Step())
+		{
+			out[i] = typename Base::Vector3(Sample(firstIndex + uint32_t(i), 0), y.Value(), z.Value());
+		}
+	}
+	
+private:
+	
+	uint32_t mask2;
+	uint8_t offset3[Digits3];
+	uint8_t offset5[Digits5];
+	
+	static T Normalize(const uint64_t reversed, const uint64_t scale)
+	{
+		return qMin(T(double(reversed) / double(scale)), T(1.0 - 1.0 / 16777216.0));
+	}
+	
+	//every level is visited, not just the index's own digits, so scrambled leading zeros still count. the digits are
+	//gathered reversed into an integer and divided out once
+	template<uint32_t B, int DIGITS>
+	static T RadicalInverse(uint32_t index, const uint8_t* offset)
+	{
+		uint64_t reversed = 0;
+		uint64_t scale = 1;
+		for(int level = 0; level < DIGITS; ++level)
+		{
+			const uint32_t digit = index % B + offset[level];
+			index /= B;
+			reversed = reversed * B + (digit >= B ? digit - B : digit);
+			scale *= B;
+		}
+		return Normalize(reversed, scale);
+	}
+	
+	//the same radical inverse stepped from one index to the next; a carry touches one level on average, so Fill pays
+	//constant time per point instead of every level
+	template<uint32_t B, int DIGITS>
+	struct Walker
+	{
+		const uint8_t* offset;
+		uint8_t digit[DIGITS];
+		uint64_t weight[DIGITS];
+		uint64_t reversed;
+		uint64_t scale;
+		
+		Walker(uint32_t index, const uint8_t* _offset)
+		: offset(_offset)
+		, reversed(0)
+		, scale(1)
+		{
+			for(int level = DIGITS - 1; level >= 0; --level)
+			{
+				weight[level] = scale;
+				scale *= B;
+			}
+			for(int level = 0; level < DIGITS; ++level)
+			{
+				digit[level] = uint8_t(index % B);
+				index /= B;
+				reversed += Scrambled(level) * weight[level];
+			}
+		}
+		
+		uint64_t Scrambled(const int level) const
+		{
+			const uint32_t d = digit[level] + offset[level];
+			return d >= B ? d - B : d;
+		}
+		
+		void Step()
+		{
+			for(int level = 0; level < DIGITS; ++level)
+			{
+				reversed -= Scrambled(level) * weight[level];
+				const bool carry = ++digit[level] == B;
+				if(carry)
+				{
+					digit[level] = 0;
+				}
+				reversed += Scrambled(level) * weight[level];
+				if(!carry)
+				{
+					return;
+				}
+			}
+		}
+		
+		T Value() const
+		{
+			return Normalize(reversed, scale);
+		}
+	};
+};
+
+#pragma mark Sobol
+
+//the first three Sobol dimensions with Joe and Kuo's direction numbers, indexed in Gray code order so Fill steps by one xor.
+//scrambling is Burley's hash based Owen scramble, nested uniform per dimension
+template<typename T>
+class qSobol_T : public qSequence_T<qSobol_T<T>, T>
+{
+	typedef qSequence_T<qSobol_T<T>, T> Base;
+	
+public:
+	
+	typedef typename Base::Vector2 Vector2;
+	typedef typename Base::Vector3 Vector3;
+	
+	explicit qSobol_T(const uint32_t _seed = 0)
+	{
+		for(int i = 0; i < 32; ++i)
+		{
+			direction[0][i] = 1u << (31 - i);
+		}
+		
+		//x + 1, m = { 1 }
+		direction[1][0] = 1u << 31;
+		for(int i = 1; i < 32; ++i)
+		{
+			direction[1][i] = direction[1][i - 1] ^ (direction[1][i - 1] >> 1);
+		}
+		
+		//x^2 + x + 1, m = { 1, 3 }
+		direction[2][0] = 1u << 31;
+		direction[2][1] = 3u << 30;
+		for(int i = 2; i < 32; ++i)
+		{
+			direction[2][i] = direction[2][i - 2] ^ (direction[2][i - 2] >> 2) ^ direction[2][i - 1];
+		}
+		
+		for(int d = 0; d < 3; ++d)
+		{
+			seed[d] = 0;
+		}
+		if(_seed != 0)
+		{
+			qRandomEngine engine(_seed);
+			for(int d = 0; d < 3; ++d)
+			{
+				seed[d] = engine.Next32();
+			}
+		}
+	}
+	
+	T Sample(const uint32_t index, const int dimension) const
+	{
+		qASSERT(dimension >= 0 && dimension < 3);
+		return Base::ToUnit(Scramble(Raw(index, dimension), dimension));
+	}
+	
+	void Fill(const uint32_t firstIndex, Vector2* out, const int count) const
+	{
+		uint32_t x = Raw(firstIndex, 0);
+		uint32_t y = Raw(firstIndex, 1);
+		for(int i = 0; i < count; ++i)
+		{
+			out[i] = Vector2(Base::ToUnit(Scramble(x, 0)), Base::ToUnit(Scramble(y, 1)));
+			const int bit = CountTrailingZeros(firstIndex + uint32_t(i) + 1);
+			x ^= direction[0][bit];
+			y ^= direction[1][bit];
+		}
+	}
+	
+	void Fill(const uint32_t firstIndex, Vector3* out, const int count) const
+	{
+		uint32_t x = Raw(firstIndex, 0);
+		uint32_t y = Raw(firstIndex, 1);
+		uint32_t z = Raw(firstIndex, 2);
+		for(int i = 0; i < count; ++i)
+		{
+			out[i] = Vector3(Base::ToUnit(Scramble(x, 0)), Base::ToUnit(Scramble(y, 1)), Base::ToUnit(Scramble(z, 2)));
+			const int bit = CountTrailingZeros(firstIndex + uint32_t(i) + 1);
+			x ^= direction[0][bit];
+			y ^= direction[1][bit];
+			z ^= direction[2][bit];
+		}
+	}
+	
+private:
+	
+	uint32_t direction[3][32];
+	uint32_t seed[3];
+	
+	static int CountTrailingZeros(const uint32_t x)
+	{
+		//x is never 0 here; index 2^32 - 1 would wrap, and there the walk has run out of points anyway
+		return x == 0 ? 31 : __builtin_ctz(x);
+	}
+	
+	uint32_t Raw(const uint32_t index, const int dimension) const
+	{
+		const uint32_t gray = index ^ (index >> 1);
+		uint32_t result = 0;
+		for(int bit = 0; bit < 32; ++bit)
+		{
+			result ^= direction[dimension][bit] & (0u - ((gray >> bit) & 1u));
+		}
+		return result;
+	}
+	
+	//Laine and Karras' permutation on the bit reversed value flips each bit based only on the bits above it
+	uint32_t Scramble(uint32_t x, const int dimension) const
+	{
+		if(seed[dimension] == 0)
+		{
+			return x;
+		}
+		x = Base::ReverseBits(x);
+		x += seed[dimension];
+		x ^= x * 0x6C50B47Cu;
+		x ^= x * 0xB82F1E52u;
+		x ^= x * 0xC7AFE638u;
+		x ^= x * 0x8D22F6E6u;
+		return Base::ReverseBits(x);
+	}
+};
+
+#pragma mark R2
+
+//Roberts' additive recurrence on the plastic number's generalisation, kept as 32 bit fixed point so any index costs
+//one multiply and an add; the seed sets a random toroidal shift
+template<typename T>
+class qR2_T : public qSequence_T<qR2_T<T>, T>
+{
+	typedef qSequence_T<qR2_T<T>, T> Base;
+	
+public:
+	
+	explicit qR2_T(const uint32_t seed = 0)
+	{
+		for(int d = 0; d < 3; ++d)
+		{
+			offset[d] = 0x80000000u;
+		}
+		if(seed != 0)
+		{
+			qRandomEngine engine(seed);
+			for(int d = 0; d < 3; ++d)
+			{
+				offset[d] = engine.Next32();
+			}
+		}
+	}
+	
+	//the 3D sequence's components; Sample2 is the 2D sequence, which steps by powers of 1 / 1.3247... rather than 1 / 1.2207...
+	T Sample(const uint32_t index, const int dimension) const
+	{
+		qASSERT(dimension >= 0 && dimension < 3);
+		const uint32_t alpha = dimension == 0 ? Alpha3x : (dimension == 1 ? Alpha3y : Alpha3z);
+		return Base::ToUnit(offset[dimension] + index * alpha);
+	}
+	
+	typename Base::Vector2 Sample2(const uint32_t index) const
+	{
+		return typename Base::Vector2(Base::ToUnit(offset[0] + index * Alpha2x), Base::ToUnit(offset[1] + index * Alpha2y));
+	}
+	
+	typename Base::Vector3 Sample3(const uint32_t index) const
+	{
+		return typename Base::Vector3(Base::ToUnit(offset[0] + index * Alpha3x), Base::ToUnit(offset[1] + index * Alpha3y), Base::ToUnit(offset[2] + index * Alpha3z));
+	}
+	
+private:
+	
+	static const uint32_t Alpha2x = 0xC13FA9A9u;
+	static const uint32_t Alpha2y = 0x91E10DA6u;
+	static const uint32_t Alpha3x = 0xD1B54A33u;
+	static const uint32_t Alpha3y = 0xABC98389u;
+	static const uint32_t Alpha3z = 0x8CB92BA7u;
+	
+	uint32_t offset[3];
+};
+
+#pragma mark blue noise
+
+//the ranks of a 64x64 void and cluster tile, built on first use
+const uint16_t* qBlueNoiseTile();
+
+//blue noise per pixel: index walks the tile row by row and each dimension reads it at a fixed toroidal offset.
+//neighbouring indices differ as much as possible, which suits per pixel dithering or rotating another sequence
+template<typename T>
+class qBlueNoise_T : public qSequence_T<qBlueNoise_T<T>, T>
+{
+public:
+	
+	static const int Size = 64;
+	
+	T Sample(const uint32_t index, const int dimension) const
+	{
+		return SamplePixel(int(index % Size), int((index / Size) % Size), dimension);
+	}
+	
+	//x and y wrap, so any pixel coordinate reads the tile
+	T SamplePixel(const int x, const int y, const int dimension = 0) const
+	{
+		qASSERT(dimension >= 0 && dimension < 3);
+		static const int shift[3][2] = { { 0, 0 }, { 37, 23 }, { 19, 45 } };
+		const int px = (x + shift[dimension][0]) & (Size - 1);
+		const int py = (y + shift[dimension][1]) & (Size - 1);
+		return (T(qBlueNoiseTile()[py * Size + px]) + T(0.5)) * T(1.0 / (Size * Size));
+	}
+};
+
+typedef qHalton_T<double> qHaltond;
+typedef qHalton_T<float> qHalton;
+typedef qSobol_T<double> qSobold;
+typedef qSobol_T<float> qSobol;
+typedef qR2_T<double> qR2d;
+typedef qR2_T<float> qR2;
+typedef qBlueNoise_T<double> qBlueNoised;
+typedef qBlueNoise_T<float> qBlueNoise;
+
+#endif // __Q_LOW_DISCREPANCY_H__
@@ -26,19 +26,35 @@ SOFTWARE.
 #include "qVector2.h"
 #include "qVector3.h"
 #include "qVector4.h"
+#include "qVectorSoA.h"
+#include "qVector3x.h"
+#include "qVectorN.h"
 
 #include "qMatrix2.h"
 #include "qMatrix3.h"
 #include "qMatrix4.h"
+#include "qMatrixNxM.h"
+#include "qAffine.h"
 
 #include "qPlane.h"
+#include "qAABB.h"
+#include "qFrustum.h"
 
 #include "qTriangle.h"
 #include "qQuad.h"
 
 #include "qCamera.h"
 #include "qRandom.h"
+#include "qInverseCDF.h"
 #include "qRange.h"
+#include "qRangeSampler.h"
+#include "qLowDiscrepancy.h"
+#include "qWeightedPicker.h"
+#include "qSampling.h"
+#include "qValueHash.h"
+#include "qSpatialHash.h"
+#include "qHash.h"
+#include "qParallel.h"
 #include "qUtil.h"
 #include "qRGBA.h"
 
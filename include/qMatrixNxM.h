@@ -0,0 +1,1025 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_MATRIX_NXM_H__
+#define __Q_MATRIX_NXM_H__
+
+#include <math.h>
+#include <type_traits>
+#include "qCore.h"
+#include "qSIMD.h"
+#include "qPacket.h"
+#include "qVectorN.h"
+#include <iostream>
+
+/*
+ N columns by M rows, column major and named the way GLSL names matNxM; qMatrix2/3/4 are the square sizes
+ [ mm[0][0] mm[1][0] ... mm[N-1][0]   ]
+ [ ...                                ]
+ [ mm[0][M-1] ...    mm[N-1][M-1]     ]
+*/
+
+#pragma mark kernels
+
+//lhs is N x M, rhs is K x N, out is K x M; out must not alias either side
+template<typename T, int N, int M, int K>
+struct qMatrixNxMKernel
+{
+	static inline void Multiply(T* out, const T* lhs, const T* rhs)
+	{
+		qUnroll_T<0, K>::Run([&](int c)
+		{
+			qUnroll_T<0, M>::Run([&](int r)
+			{
+				T sum = T(0);
+				qUnroll_T<0, N>::Run([&](int k) { sum += lhs[k * M + r] * rhs[c * N + k]; });
+				out[c * M + r] = sum;
+			});
+		});
+	}
+	
+	//out has M elements, v has N
+	static inline void Transform(T* out, const T* mat, const T* v)
+	{
+		qUnroll_T<0, M>::Run([&](int r)
+		{
+			T sum = T(0);
+			qUnroll_T<0, N>::Run([&](int k) { sum += mat[k * M + r] * v[k]; });
+			out[r] = sum;
+		});
+	}
+};
+
+#if qSIMD_ENABLED
+//four rows fill a register, so every output column is a sum of broadcast-scaled input columns
+template<int N, int K>
+struct qMatrixNxMKernel<float, N, 4, K>
+{
+	static inline void Multiply(float* out, const float* lhs, const float* rhs)
+	{
+		qUnroll_T<0, K>::Run([&](int c)
+		{
+			qSIMD::float4 sum = qSIMD::Mul(qSIMD::Load(lhs), qSIMD::Splat(rhs[c * N]));
+			qUnroll_T<1, N>::Run([&](int k) { sum = qSIMD::MulAdd(qSIMD::Load(lhs + k * 4), qSIMD::Splat(rhs[c * N + k]), sum); });
+			qSIMD::Store(out + c * 4, sum);
+		});
+	}
+	
+	static inline void Transform(float* out, const float* mat, const float* v)
+	{
+		qSIMD::float4 sum = qSIMD::Mul(qSIMD::Load(mat), qSIMD::Splat(v[0]));
+		qUnroll_T<1, N>::Run([&](int k) { sum = qSIMD::MulAdd(qSIMD::Load(mat + k * 4), qSIMD::Splat(v[k]), sum); });
+		qSIMD::Store(out, sum);
+	}
+};
+
+template<>
+struct qMatrixNxMKernel<float, 4, 4, 4>
+{
+	static inline void Multiply(float* out, const float* lhs, const float* rhs)		{ qSIMD::Matrix4Multiply(out, lhs, rhs); }
+	static inline void Transform(float* out, const float* mat, const float* v)		{ qSIMD::Matrix4Transform(out, mat, v); }
+};
+#endif
+
+//the 3x3 in the first three columns and rows plus the translation in column 3, with columns STRIDE apart;
+//shared by qMatrix3's Inverse, qMatrix4's InverseAffine / InverseRigid and qAffine3x4_T
+template<typename T, int STRIDE>
+struct qMatrixAffineKernel
+{
+	//returns the determinant, the caller asserts on it
+	static inline T InverseLinear(T* b, const T* a)
+	{
+		const T m00 = a[0], m01 = a[1], m02 = a[2];
+		const T m10 = a[STRIDE], m11 = a[STRIDE + 1], m12 = a[STRIDE + 2];
+		const T m20 = a[STRIDE * 2], m21 = a[STRIDE * 2 + 1], m22 = a[STRIDE * 2 + 2];
+	
+		T c00 = (m11 * m22) - (m12 * m21);
+		T c10 = (m12 * m20) - (m10 * m22);
+		T c20 = (m10 * m21) - (m11 * m20);
+		T det = (m00 * c00) + (m01 * c10) + (m02 * c20);
+		T invDet = T(1) / det;
+	
+		b[0] = c00 * invDet;
+		b[1] = ((m02 * m21) - (m01 * m22)) * invDet;
+		b[2] = ((m01 * m12) - (m02 * m11)) * invDet;
+		b[STRIDE] = c10 * invDet;
+		b[STRIDE + 1] = ((m00 * m22) - (m02 * m20)) * invDet;
+		b[STRIDE + 2] = ((m02 * m10) - (m00 * m12)) * invDet;
+		b[STRIDE * 2] = c20 * invDet;
+		b[STRIDE * 2 + 1] = ((m01 * m20) - (m00 * m21)) * invDet;
+		b[STRIDE * 2 + 2] = ((m00 * m11) - (m01 * m10)) * invDet;
+		return det;
+	}
+	
+	//orthonormal, the inverse is the transpose
+	static inline void InverseLinearOrthonormal(T* b, const T* a)
+	{
+		const T m01 = a[1], m02 = a[2], m12 = a[STRIDE + 2];
+		b[0] = a[0];
+		b[1] = a[STRIDE];
+		b[2] = a[STRIDE * 2];
+		b[STRIDE] = m01;
+		b[STRIDE + 1] = a[STRIDE + 1];
+		b[STRIDE + 2] = a[STRIDE * 2 + 1];
+		b[STRIDE * 2] = m02;
+		b[STRIDE * 2 + 1] = m12;
+		b[STRIDE * 2 + 2] = a[STRIDE * 2 + 2];
+	}
+	
+	//b already holds the inverted 3x3, carry a's translation through it
+	static inline void InverseTranslation(T* b, const T* a)
+	{
+		const T x = a[STRIDE * 3], y = a[STRIDE * 3 + 1], z = a[STRIDE * 3 + 2];
+		b[STRIDE * 3] = -((b[0] * x) + (b[STRIDE] * y) + (b[STRIDE * 2] * z));
+		b[STRIDE * 3 + 1] = -((b[1] * x) + (b[STRIDE + 1] * y) + (b[STRIDE * 2 + 1] * z));
+		b[STRIDE * 3 + 2] = -((b[2] * x) + (b[STRIDE + 2] * y) + (b[STRIDE * 2 + 2] * z));
+	}
+};
+
+#pragma mark storage
+
+template<typename T, int N, int M>
+class qMatrixNxM_T;
+
+//the elements and constructors of qMatrixNxM_T; the square sizes specialize it with named mCR members
+//(column C, row R) and the transforms and inverses that only mean something at that size
+template<typename T, int N, int M>
+class qMatrixNxMBase_T
+{
+public:
+	
+	union
+	{
+		T m[N * M];
+		T mm[N][M];
+	};
+	
+	//identity on the leading diagonal, zero elsewhere
+	constexpr qMatrixNxMBase_T()
+	: m()
+	{
+		for(int i = 0; i < (N < M ? N : M); ++i)
+		{
+			m[i * M + i] = T(1);
+		}
+	}
+	
+	template<typename... REST>
+	constexpr qMatrixNxMBase_T(const T a, const T b, const REST... rest)
+	: m{ a, b, T(rest)... }
+	{
+		static_assert(sizeof...(REST) + 2 == N * M, "qMatrixNxM_T needs exactly N * M elements");
+	}
+};
+
+template<typename T>
+class qMatrixNxMBase_T<T, 2, 2>
+{
+public:
+	
+	typedef qMatrixNxM_T<T, 2, 2> Matrix;
+	typedef qVectorN_T<T, 2> Vector2;
+	
+	union
+	{
+		struct
+		{
+			T m00;
+			T m01;
+			T m10;
+			T m11;
+		};
+		T m[4];
+		T mm[2][2];
+	};
+	
+	constexpr qMatrixNxMBase_T()
+	: m00(T(1))
+	, m01(T(0))
+	, m10(T(0))
+	, m11(T(1))
+	{
+	}
+	
+	constexpr qMatrixNxMBase_T(const T _m00, const T _m01,
+	                           const T _m10, const T _m11)
+	: m00(_m00)
+	, m01(_m01)
+	, m10(_m10)
+	, m11(_m11)
+	{}
+	
+#pragma mark util
+	
+	static Matrix Rotate(T angle)
+	{
+		Matrix rotMat;
+		rotMat.m00 = cos(angle);
+		rotMat.m10 = -sin(angle);
+		rotMat.m01 = sin(angle);
+		rotMat.m11 = cos(angle);
+		return rotMat;
+	}
+	
+	static Matrix Scale(const Vector2 &scale)
+	{
+		Matrix scaleMat;
+		scaleMat.m00 = scale.x;
+		scaleMat.m11 = scale.y;
+		return scaleMat;
+	}
+	
+#pragma mark inverse
+	
+	T Determinant() const
+	{
+		return Determinant(static_cast<const Matrix&>(*this));
+	}
+	
+	void Invert()
+	{
+		static_cast<Matrix&>(*this) = Inverse(static_cast<const Matrix&>(*this));
+	}
+	
+	static T Determinant(const Matrix &mat)
+	{
+		return (mat.m00 * mat.m11) - (mat.m10 * mat.m01);
+	}
+	
+	static Matrix Inverse(const Matrix &mat)
+	{
+		T det = Determinant(mat);
+		qASSERT(det != T(0));
+		T invDet = T(1) / det;
+		return Matrix(mat.m11 * invDet, -mat.m01 * invDet,
+		              -mat.m10 * invDet, mat.m00 * invDet);
+	}
+};
+
+template<typename T>
+class qMatrixNxMBase_T<T, 3, 3>
+{
+public:
+	
+	typedef qMatrixNxM_T<T, 3, 3> Matrix;
+	typedef qVectorN_T<T, 3> Vector3;
+	
+	union
+	{
+		struct
+		{
+			T m00;
+			T m01;
+			T m02;
+			T m10;
+			T m11;
+			T m12;
+			T m20;
+			T m21;
+			T m22;
+		};
+		T m[9];
+		T mm[3][3];
+	};
+	
+	constexpr qMatrixNxMBase_T()
+	: m00(T(1))
+	, m01(T(0))
+	, m02(T(0))
+	, m10(T(0))
+	, m11(T(1))
+	, m12(T(0))
+	, m20(T(0))
+	, m21(T(0))
+	, m22(T(1))
+	{
+	}
+	
+	constexpr qMatrixNxMBase_T(const T _m00, const T _m01, const T _m02,
+	                           const T _m10, const T _m11, const T _m12,
+	                           const T _m20, const T _m21, const T _m22)
+	: m00(_m00)
+	, m01(_m01)
+	, m02(_m02)
+	, m10(_m10)
+	, m11(_m11)
+	, m12(_m12)
+	, m20(_m20)
+	, m21(_m21)
+	, m22(_m22)
+	{}
+	
+#pragma mark util
+	
+	static Matrix RotateAroundX(T angle)
+	{
+		Matrix rotMat;
+		rotMat.m11 = cos(angle);
+		rotMat.m21 = -sin(angle);
+		rotMat.m12 = sin(angle);
+		rotMat.m22 = cos(angle);
+		return rotMat;
+	}
+	
+	static Matrix RotateAroundY(T angle)
+	{
+		Matrix rotMat;
+		rotMat.m00 = cos(angle);
+		rotMat.m20 = -sin(angle);
+		rotMat.m02 = sin(angle);
+		rotMat.m22 = cos(angle);
+		return rotMat;
+	}
+	
+	static Matrix RotateAroundZ(T angle)
+	{
+		Matrix rotMat;
+		rotMat.m00 = cos(angle);
+		rotMat.m10 = -sin(angle);
+		rotMat.m01 = sin(angle);
+		rotMat.m11 = cos(angle);
+		return rotMat;
+	}
+	
+	static Matrix Scale(const Vector3 &scale)
+	{
+		Matrix scaleMat;
+		scaleMat.m00 = scale.x;
+		scaleMat.m11 = scale.y;
+		scaleMat.m22 = scale.z;
+		return scaleMat;
+	}
+	
+#pragma mark inverse
+	
+	T Determinant() const
+	{
+		return Determinant(static_cast<const Matrix&>(*this));
+	}
+	
+	void Invert()
+	{
+		static_cast<Matrix&>(*this) = Inverse(static_cast<const Matrix&>(*this));
+	}
+	
+	static T Determinant(const Matrix &mat)
+	{
+		return mat.m00 * ((mat.m11 * mat.m22) - (mat.m12 * mat.m21))
+			 - mat.m01 * ((mat.m10 * mat.m22) - (mat.m12 * mat.m20))
+			 + mat.m02 * ((mat.m10 * mat.m21) - (mat.m11 * mat.m20));
+	}
+	
+	static Matrix Inverse(const Matrix &mat)
+	{
+		Matrix out;
+		T det = qMatrixAffineKernel<T, 3>::InverseLinear(out.m, mat.m);
+		qASSERT(det != T(0));
+		(void)det;
+		return out;
+	}
+	
+	//pure rotation, the inverse is the transpose
+	static Matrix InverseOrthonormal(const Matrix &mat)
+	{
+		Matrix out = mat;
+		out.Transpose();
+		return out;
+	}
+	
+	//pure scale along the axes
+	static Matrix InverseScale(const Matrix &mat)
+	{
+		qASSERT(mat.m00 != T(0));
+		qASSERT(mat.m11 != T(0));
+		qASSERT(mat.m22 != T(0));
+		Matrix out;
+		out.m00 = T(1) / mat.m00;
+		out.m11 = T(1) / mat.m11;
+		out.m22 = T(1) / mat.m22;
+		return out;
+	}
+};
+
+template<typename T>
+class qMatrixNxMBase_T<T, 4, 4>
+{
+public:
+	
+	typedef qMatrixNxM_T<T, 4, 4> Matrix;
+	typedef qVectorN_T<T, 3> Vector3;
+	typedef qVectorN_T<T, 4> Vector4;
+	
+	union
+	{
+		struct
+		{
+			T m00;
+			T m01;
+			T m02;
+			T m03;
+			T m10;
+			T m11;
+			T m12;
+			T m13;
+			T m20;
+			T m21;
+			T m22;
+			T m23;
+			T m30;
+			T m31;
+			T m32;
+			T m33;
+		};
+		T m[16];
+		T mm[4][4];
+	};
+	
+	constexpr qMatrixNxMBase_T()
+	: m00(T(1))
+	, m01(T(0))
+	, m02(T(0))
+	, m03(T(0))
+	, m10(T(0))
+	, m11(T(1))
+	, m12(T(0))
+	, m13(T(0))
+	, m20(T(0))
+	, m21(T(0))
+	, m22(T(1))
+	, m23(T(0))
+	, m30(T(0))
+	, m31(T(0))
+	, m32(T(0))
+	, m33(T(1))
+	{
+	}
+	
+	constexpr qMatrixNxMBase_T(const T _m00, const T _m01, const T _m02, const T _m03,
+	                           const T _m10, const T _m11, const T _m12, const T _m13,
+	                           const T _m20, const T _m21, const T _m22, const T _m23,
+	                           const T _m30, const T _m31, const T _m32, const T _m33)
+	: m00(_m00)
+	, m01(_m01)
+	, m02(_m02)
+	, m03(_m03)
+	, m10(_m10)
+	, m11(_m11)
+	, m12(_m12)
+	, m13(_m13)
+	, m20(_m20)
+	, m21(_m21)
+	, m22(_m22)
+	, m23(_m23)
+	, m30(_m30)
+	, m31(_m31)
+	, m32(_m32)
+	, m33(_m33)
+	{}
+	
+#pragma mark util
+	
+	static Matrix RotateAroundX(T angle)
+	{
+		Matrix rotMat;
+		rotMat.m11 = cos(angle);
+		rotMat.m21 = -sin(angle);
+		rotMat.m12 = sin(angle);
+		rotMat.m22 = cos(angle);
+		return rotMat;
+	}
+	
+	static Matrix RotateAroundY(T angle)
+	{
+		Matrix rotMat;
+		rotMat.m00 = cos(angle);
+		rotMat.m20 = -sin(angle);
+		rotMat.m02 = sin(angle);
+		rotMat.m22 = cos(angle);
+		return rotMat;
+	}
+	
+	static Matrix RotateAroundZ(T angle)
+	{
+		Matrix rotMat;
+		rotMat.m00 = cos(angle);
+		rotMat.m10 = -sin(angle);
+		rotMat.m01 = sin(angle);
+		rotMat.m11 = cos(angle);
+		return rotMat;
+	}
+	
+	static Matrix Translate(const Vector3 &translate)
+	{
+		Matrix transMat;
+		transMat.m30 = translate.x;
+		transMat.m31 = translate.y;
+		transMat.m32 = translate.z;
+		return transMat;
+	}
+	
+	static Matrix Scale(const Vector3 &scale)
+	{
+		Matrix scaleMat;
+		scaleMat.m00 = scale.x;
+		scaleMat.m11 = scale.y;
+		scaleMat.m22 = scale.z;
+		return scaleMat;
+	}
+	
+#pragma mark inverse
+	
+	T Determinant() const
+	{
+		return Determinant(static_cast<const Matrix&>(*this));
+	}
+	
+	void Invert()
+	{
+		static_cast<Matrix&>(*this) = Inverse(static_cast<const Matrix&>(*this));
+	}
+	
+	static T Determinant(const Matrix &mat)
+	{
+		T s0 = (mat.m00 * mat.m11) - (mat.m10 * mat.m01);
+		T s1 = (mat.m00 * mat.m12) - (mat.m10 * mat.m02);
+		T s2 = (mat.m00 * mat.m13) - (mat.m10 * mat.m03);
+		T s3 = (mat.m01 * mat.m12) - (mat.m11 * mat.m02);
+		T s4 = (mat.m01 * mat.m13) - (mat.m11 * mat.m03);
+		T s5 = (mat.m02 * mat.m13) - (mat.m12 * mat.m03);
+		T c5 = (mat.m22 * mat.m33) - (mat.m32 * mat.m23);
+		T c4 = (mat.m21 * mat.m33) - (mat.m31 * mat.m23);
+		T c3 = (mat.m21 * mat.m32) - (mat.m31 * mat.m22);
+		T c2 = (mat.m20 * mat.m33) - (mat.m30 * mat.m23);
+		T c1 = (mat.m20 * mat.m32) - (mat.m30 * mat.m22);
+		T c0 = (mat.m20 * mat.m31) - (mat.m30 * mat.m21);
+		return (s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) - (s4 * c1) + (s5 * c0);
+	}
+	
+	static Matrix Inverse(const Matrix &mat)
+	{
+		Matrix out;
+		T det = InverseKernel(mat.m, out.m);
+		qASSERT(det != T(0));
+		(void)det;
+		return out;
+	}
+	
+	//last row is [ 0 0 0 1 ]: invert the 3x3 and carry the translation through it
+	static Matrix InverseAffine(const Matrix &mat)
+	{
+		Matrix out;
+		T det = qMatrixAffineKernel<T, 4>::InverseLinear(out.m, mat.m);
+		qASSERT(det != T(0));
+		(void)det;
+		qMatrixAffineKernel<T, 4>::InverseTranslation(out.m, mat.m);
+		return out;
+	}
+	
+	//orthonormal rotation plus translation, e.g. from qCamera::LookAt
+	static Matrix InverseRigid(const Matrix &mat)
+	{
+		Matrix out;
+		qMatrixAffineKernel<T, 4>::InverseLinearOrthonormal(out.m, mat.m);
+		qMatrixAffineKernel<T, 4>::InverseTranslation(out.m, mat.m);
+		return out;
+	}
+	
+	//pure scale along the axes
+	static Matrix InverseScale(const Matrix &mat)
+	{
+		qASSERT(mat.m00 != T(0));
+		qASSERT(mat.m11 != T(0));
+		qASSERT(mat.m22 != T(0));
+		Matrix out;
+		out.m00 = T(1) / mat.m00;
+		out.m11 = T(1) / mat.m11;
+		out.m22 = T(1) / mat.m22;
+		return out;
+	}
+	
+	//count general inverses, qPACKET_WIDTH float matrices at a time with one matrix per lane; out may alias in
+	static void Inverse(const Matrix* in, Matrix* out, const int count)
+	{
+		if(count > 0)
+		{
+			InverseArrayKernel(out[0].m, in[0].m, count);
+		}
+	}
+	
+	static void InverseAffine(const Matrix* in, Matrix* out, const int count)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			out[i] = InverseAffine(in[i]);
+		}
+	}
+	
+	static void InverseRigid(const Matrix* in, Matrix* out, const int count)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			out[i] = InverseRigid(in[i]);
+		}
+	}
+	
+#pragma mark batch
+	
+	//points are promoted with w = 1, directions with w = 0; out may alias in
+	static void TransformPoints(const Matrix &mat, const Vector3* in, Vector3* out, const int count)
+	{
+		if(count > 0)
+		{
+			TransformArray3Kernel(out[0].v, mat.m, in[0].v, count, T(1));
+		}
+	}
+	
+	static void TransformDirections(const Matrix &mat, const Vector3* in, Vector3* out, const int count)
+	{
+		if(count > 0)
+		{
+			TransformArray3Kernel(out[0].v, mat.m, in[0].v, count, T(0));
+		}
+	}
+	
+	//points are promoted with w = 1 and written out in full, e.g. to clip space
+	static void TransformHomogeneous(const Matrix &mat, const Vector3* in, Vector4* out, const int count)
+	{
+		if(count > 0)
+		{
+			TransformArray3To4Kernel(out[0].v, mat.m, in[0].v, count);
+		}
+	}
+	
+	//out may alias in
+	static void TransformHomogeneous(const Matrix &mat, const Vector4* in, Vector4* out, const int count)
+	{
+		if(count > 0)
+		{
+			TransformArray4Kernel(out[0].v, mat.m, in[0].v, count);
+		}
+	}
+	
+private:
+	
+	//scalar reference kernels for any T, with float overloads that take the qSIMD paths
+	
+	template<typename E>
+	static void TransformKernel(E* out, const E* mat, const E* v)
+	{
+		E x = v[0], y = v[1], z = v[2], w = v[3];
+		out[0] = (mat[0] * x) + (mat[4] * y) + (mat[8] * z) + (mat[12] * w);
+		out[1] = (mat[1] * x) + (mat[5] * y) + (mat[9] * z) + (mat[13] * w);
+		out[2] = (mat[2] * x) + (mat[6] * y) + (mat[10] * z) + (mat[14] * w);
+		out[3] = (mat[3] * x) + (mat[7] * y) + (mat[11] * z) + (mat[15] * w);
+	}
+	
+	template<typename E>
+	static void TransformArray3Kernel(E* out, const E* mat, const E* in, const int count, const E w)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			E x = in[i * 3 + 0], y = in[i * 3 + 1], z = in[i * 3 + 2];
+			out[i * 3 + 0] = (mat[0] * x) + (mat[4] * y) + (mat[8] * z) + (mat[12] * w);
+			out[i * 3 + 1] = (mat[1] * x) + (mat[5] * y) + (mat[9] * z) + (mat[13] * w);
+			out[i * 3 + 2] = (mat[2] * x) + (mat[6] * y) + (mat[10] * z) + (mat[14] * w);
+		}
+	}
+	
+	template<typename E>
+	static void TransformArray3To4Kernel(E* out, const E* mat, const E* in, const int count)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			E v[4] = { in[i * 3 + 0], in[i * 3 + 1], in[i * 3 + 2], E(1) };
+			TransformKernel(out + i * 4, mat, v);
+		}
+	}
+	
+	template<typename E>
+	static void TransformArray4Kernel(E* out, const E* mat, const E* in, const int count)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			TransformKernel(out + i * 4, mat, in + i * 4);
+		}
+	}
+	
+	template<typename E>
+	static void InverseArrayKernel(E* out, const E* in, const int count)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			E inv[16];
+			E det = InverseKernel(in + i * 16, inv);
+			qASSERT(det != E(0));
+			(void)det;
+	
+			for(int e = 0; e < 16; ++e)
+			{
+				out[i * 16 + e] = inv[e];
+			}
+		}
+	}
+	
+#if qSIMD_ENABLED
+	static void TransformKernel(float* out, const float* mat, const float* v)
+	{
+		qSIMD::Matrix4Transform(out, mat, v);
+	}
+	
+	static void TransformArray3Kernel(float* out, const float* mat, const float* in, const int count, const float w)
+	{
+		qSIMD::Matrix4TransformArray3(out, mat, in, count, w);
+	}
+	
+	static void TransformArray3To4Kernel(float* out, const float* mat, const float* in, const int count)
+	{
+		qSIMD::Matrix4TransformArray3To4(out, mat, in, count);
+	}
+	
+	static void TransformArray4Kernel(float* out, const float* mat, const float* in, const int count)
+	{
+		qSIMD::Matrix4TransformArray4(out, mat, in, count);
+	}
+#endif
+	
+	static void InverseArrayKernel(float* out, const float* in, const int count)
+	{
+		typedef qFloatx_T<qPACKET_WIDTH> Float;
+	
+		int i = 0;
+		for(; i + qPACKET_WIDTH <= count; i += qPACKET_WIDTH)
+		{
+			float lanes[16][qPACKET_WIDTH];
+			for(int l = 0; l < qPACKET_WIDTH; ++l)
+			{
+				for(int e = 0; e < 16; ++e)
+				{
+					lanes[e][l] = in[(i + l) * 16 + e];
+				}
+			}
+	
+			Float a[16];
+			Float b[16];
+			for(int e = 0; e < 16; ++e)
+			{
+				a[e] = Float::Load(lanes[e]);
+			}
+			InverseKernel(a, b);
+			for(int e = 0; e < 16; ++e)
+			{
+				b[e].Store(lanes[e]);
+			}
+	
+			for(int l = 0; l < qPACKET_WIDTH; ++l)
+			{
+				for(int e = 0; e < 16; ++e)
+				{
+					out[(i + l) * 16 + e] = lanes[e][l];
+				}
+			}
+		}
+	
+		for(; i < count; ++i)
+		{
+			float inv[16];
+			float det = InverseKernel(in + i * 16, inv);
+			qASSERT(det != 0.0f);
+			(void)det;
+	
+			for(int e = 0; e < 16; ++e)
+			{
+				out[i * 16 + e] = inv[e];
+			}
+		}
+	}
+	
+	//cofactor expansion through 2x2 sub-determinants; E is a scalar, or a packet holding one matrix per lane
+	template<typename E>
+	static E InverseKernel(const E* a, E* b)
+	{
+		E s0 = (a[0] * a[5]) - (a[4] * a[1]);
+		E s1 = (a[0] * a[6]) - (a[4] * a[2]);
+		E s2 = (a[0] * a[7]) - (a[4] * a[3]);
+		E s3 = (a[1] * a[6]) - (a[5] * a[2]);
+		E s4 = (a[1] * a[7]) - (a[5] * a[3]);
+		E s5 = (a[2] * a[7]) - (a[6] * a[3]);
+		E c5 = (a[10] * a[15]) - (a[14] * a[11]);
+		E c4 = (a[9] * a[15]) - (a[13] * a[11]);
+		E c3 = (a[9] * a[14]) - (a[13] * a[10]);
+		E c2 = (a[8] * a[15]) - (a[12] * a[11]);
+		E c1 = (a[8] * a[14]) - (a[12] * a[10]);
+		E c0 = (a[8] * a[13]) - (a[12] * a[9]);
+	
+		E det = (s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) - (s4 * c1) + (s5 * c0);
+		E invDet = E(1) / det;
+	
+		b[0] = ((a[5] * c5) - (a[6] * c4) + (a[7] * c3)) * invDet;
+		b[1] = ((a[2] * c4) - (a[1] * c5) - (a[3] * c3)) * invDet;
+		b[2] = ((a[13] * s5) - (a[14] * s4) + (a[15] * s3)) * invDet;
+		b[3] = ((a[10] * s4) - (a[9] * s5) - (a[11] * s3)) * invDet;
+		b[4] = ((a[6] * c2) - (a[4] * c5) - (a[7] * c1)) * invDet;
+		b[5] = ((a[0] * c5) - (a[2] * c2) + (a[3] * c1)) * invDet;
+		b[6] = ((a[14] * s2) - (a[12] * s5) - (a[15] * s1)) * invDet;
+		b[7] = ((a[8] * s5) - (a[10] * s2) + (a[11] * s1)) * invDet;
+		b[8] = ((a[4] * c4) - (a[5] * c2) + (a[7] * c0)) * invDet;
+		b[9] = ((a[1] * c2) - (a[0] * c4) - (a[3] * c0)) * invDet;
+		b[10] = ((a[12] * s4) - (a[13] * s2) + (a[15] * s0)) * invDet;
+		b[11] = ((a[9] * s2) - (a[8] * s4) - (a[11] * s0)) * invDet;
+		b[12] = ((a[5] * c1) - (a[4] * c3) - (a[6] * c0)) * invDet;
+		b[13] = ((a[0] * c3) - (a[1] * c1) + (a[2] * c0)) * invDet;
+		b[14] = ((a[13] * s1) - (a[12] * s3) - (a[14] * s0)) * invDet;
+		b[15] = ((a[8] * s3) - (a[9] * s1) + (a[10] * s0)) * invDet;
+		return det;
+	}
+};
+
+#pragma mark matrix
+
+template<typename T, int N, int M>
+class qMatrixNxM_T : public qMatrixNxMBase_T<T, N, M>
+{
+public:
+	
+	static_assert(N > 0 && M > 0, "qMatrixNxM_T needs at least one row and column");
+	
+	typedef qMatrixNxMBase_T<T, N, M> Base;
+	typedef T Element;
+	typedef qVectorN_T<T, M> Column;
+	typedef qVectorN_T<T, N> Row;
+	enum { Columns = N, Rows = M, Size = N * M };
+	
+	using Base::Base;
+	using Base::m;
+	using Base::mm;
+	
+	static qMatrixNxM_T Load(const T* p)
+	{
+		qMatrixNxM_T out;
+		qUnroll_T<0, N * M>::Run([&](int i) { out.m[i] = p[i]; });
+		return out;
+	}
+	
+	void Store(T* p) const
+	{
+		qUnroll_T<0, N * M>::Run([&](int i) { p[i] = m[i]; });
+	}
+	
+#pragma mark getters
+	
+	T& operator[](int pos)
+	{
+		qASSERT(pos < N * M);
+		return m[pos];
+	}
+	
+	T operator[](int pos) const
+	{
+		qASSERT(pos < N * M);
+		return m[pos];
+	}
+	
+	Column GetColumn(int c) const
+	{
+		qASSERT(c < N);
+		return Column::Load(mm[c]);
+	}
+	
+	Row GetRow(int r) const
+	{
+		qASSERT(r < M);
+		Row out;
+		qUnroll_T<0, N>::Run([&](int c) { out.v[c] = mm[c][r]; });
+		return out;
+	}
+	
+	void SetColumn(int c, const Column &col)
+	{
+		qASSERT(c < N);
+		col.Store(mm[c]);
+	}
+	
+	void SetRow(int r, const Row &row)
+	{
+		qASSERT(r < M);
+		qUnroll_T<0, N>::Run([&](int c) { mm[c][r] = row.v[c]; });
+	}
+	
+#pragma mark arithmetic
+	
+	qMatrixNxM_T operator+(const T f) const						{ qMatrixNxM_T temp; qVectorNKernel<T, N * M>::Offset(temp.m, m, f); return temp; }
+	qMatrixNxM_T operator+(const qMatrixNxM_T &rhs) const		{ qMatrixNxM_T temp; qVectorNKernel<T, N * M>::Add(temp.m, m, rhs.m); return temp; }
+	qMatrixNxM_T operator-(const T f) const						{ qMatrixNxM_T temp; qVectorNKernel<T, N * M>::Offset(temp.m, m, -f); return temp; }
+	qMatrixNxM_T operator-(const qMatrixNxM_T &rhs) const		{ qMatrixNxM_T temp; qVectorNKernel<T, N * M>::Sub(temp.m, m, rhs.m); return temp; }
+	qMatrixNxM_T operator*(const T f) const						{ qMatrixNxM_T temp; qVectorNKernel<T, N * M>::Scale(temp.m, m, f); return temp; }
+	qMatrixNxM_T operator/(const T f) const						{ qASSERT(f != T(0)); qMatrixNxM_T temp; qVectorNKernel<T, N * M>::Divide(temp.m, m, f); return temp; }
+	qMatrixNxM_T operator/(const qMatrixNxM_T &rhs) const		{ qMatrixNxM_T temp; qVectorNKernel<T, N * M>::Div(temp.m, m, rhs.m); return temp; }
+	
+	qMatrixNxM_T& operator+=(const T f)							{ qVectorNKernel<T, N * M>::Offset(m, m, f); return *this; }
+	qMatrixNxM_T& operator+=(const qMatrixNxM_T &rhs)			{ qVectorNKernel<T, N * M>::Add(m, m, rhs.m); return *this; }
+	qMatrixNxM_T& operator-=(const T f)							{ qVectorNKernel<T, N * M>::Offset(m, m, -f); return *this; }
+	qMatrixNxM_T& operator-=(const qMatrixNxM_T &rhs)			{ qVectorNKernel<T, N * M>::Sub(m, m, rhs.m); return *this; }
+	qMatrixNxM_T& operator*=(const T f)							{ qVectorNKernel<T, N * M>::Scale(m, m, f); return *this; }
+	qMatrixNxM_T& operator/=(const T f)							{ qASSERT(f != T(0)); qVectorNKernel<T, N * M>::Divide(m, m, f); return *this; }
+	qMatrixNxM_T& operator/=(const qMatrixNxM_T &rhs)			{ qVectorNKernel<T, N * M>::Div(m, m, rhs.m); return *this; }
+	
+#pragma mark multiplication
+	
+	//(N x M) * (K x N) = (K x M)
+	template<int K>
+	qMatrixNxM_T<T, K, M> operator*(const qMatrixNxM_T<T, K, N> &rhs) const
+	{
+		qMatrixNxM_T<T, K, M> out;
+		qMatrixNxMKernel<T, N, M, K>::Multiply(out.m, m, rhs.m);
+		return out;
+	}
+	
+	qMatrixNxM_T& operator*=(const qMatrixNxM_T<T, N, N> &rhs)
+	{
+		qMatrixNxM_T out;
+		qMatrixNxMKernel<T, N, M, N>::Multiply(out.m, m, rhs.m);
+		(*this) = out;
+		return *this;
+	}
+	
+	Column operator*(const Row &rhs) const
+	{
+		Column out;
+		qMatrixNxMKernel<T, N, M, 1>::Transform(out.v, m, rhs.v);
+		return out;
+	}
+	
+#pragma mark util
+	
+	static qMatrixNxM_T Identity()
+	{
+		return qMatrixNxM_T();
+	}
+	
+	void Transpose()
+	{
+		static_assert(N == M, "only a square matrix can be transposed in place");
+		(*this) = Transpose(*this);
+	}
+	
+	static qMatrixNxM_T<T, M, N> Transpose(const qMatrixNxM_T &mat)
+	{
+		qMatrixNxM_T<T, M, N> out;
+		qUnroll_T<0, N>::Run([&](int c)
+		{
+			qUnroll_T<0, M>::Run([&](int r) { out.mm[r][c] = mat.mm[c][r]; });
+		});
+		return out;
+	}
+	
+	friend std::ostream& operator<<(std::ostream& out, const qMatrixNxM_T& mat)
+	{
+		for(int r = 0; r < M; ++r)
+		{
+			out << "[";
+			for(int c = 0; c < N; ++c)
+			{
+				out << (c ? ", " : "") << mat.mm[c][r];
+			}
+			out << "]" << std::endl;
+		}
+		return out;
+	}
+};
+
+typedef qMatrixNxM_T<float, 2, 3> qMatrix2x3;
+typedef qMatrixNxM_T<float, 3, 2> qMatrix3x2;
+typedef qMatrixNxM_T<float, 2, 4> qMatrix2x4;
+typedef qMatrixNxM_T<float, 4, 2> qMatrix4x2;
+typedef qMatrixNxM_T<float, 3, 4> qMatrix3x4;
+typedef qMatrixNxM_T<float, 4, 3> qMatrix4x3;
+
+typedef qMatrixNxM_T<double, 2, 3> qMatrix2x3d;
+typedef qMatrixNxM_T<double, 3, 2> qMatrix3x2d;
+typedef qMatrixNxM_T<double, 2, 4> qMatrix2x4d;
+typedef qMatrixNxM_T<double, 4, 2> qMatrix4x2d;
+typedef qMatrixNxM_T<double, 3, 4> qMatrix3x4d;
+typedef qMatrixNxM_T<double, 4, 3> qMatrix4x3d;
+
+static_assert(std::is_trivially_copyable<qMatrix4x3>::value, "qMatrix4x3 must be trivially copyable");
+
+#endif // __Q_MATRIX_NXM_H__
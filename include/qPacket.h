@@ -0,0 +1,426 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_PACKET_H__
+#define __Q_PACKET_H__
+
+#include <stdint.h>
+#include "qCore.h"
+#include "qSIMD.h"
+#include "qUtil.h"
+
+//widest float register of the target; AVX gives 8 lanes, SSE and NEON give 4
+#if qSIMD_AVX
+	#define qPACKET_WIDTH 8
+#else
+	#define qPACKET_WIDTH 4
+#endif
+
+#pragma mark lane operations
+
+//W lanes of float held as plain arrays; the fallback when the target has no register of that width
+template<int W>
+struct qPacketOps
+{
+	struct reg
+	{
+		float f[W];
+	};
+	
+	struct mask
+	{
+		uint32_t m[W];
+	};
+	
+	static reg Load(const float* p)
+	{
+		reg r;
+		for(int i = 0; i < W; ++i) r.f[i] = p[i];
+		return r;
+	}
+	
+	static void Store(float* p, const reg a)
+	{
+		for(int i = 0; i < W; ++i) p[i] = a.f[i];
+	}
+	
+	static reg Splat(const float f)
+	{
+		reg r;
+		for(int i = 0; i < W; ++i) r.f[i] = f;
+		return r;
+	}
+	
+	static reg Add(const reg a, const reg b)	{ reg r; for(int i = 0; i < W; ++i) r.f[i] = a.f[i] + b.f[i]; return r; }
+	static reg Sub(const reg a, const reg b)	{ reg r; for(int i = 0; i < W; ++i) r.f[i] = a.f[i] - b.f[i]; return r; }
+	static reg Mul(const reg a, const reg b)	{ reg r; for(int i = 0; i < W; ++i) r.f[i] = a.f[i] * b.f[i]; return r; }
+	static reg Div(const reg a, const reg b)	{ reg r; for(int i = 0; i < W; ++i) r.f[i] = a.f[i] / b.f[i]; return r; }
+	static reg Min(const reg a, const reg b)	{ reg r; for(int i = 0; i < W; ++i) r.f[i] = qMin(a.f[i], b.f[i]); return r; }
+	static reg Max(const reg a, const reg b)	{ reg r; for(int i = 0; i < W; ++i) r.f[i] = qMax(a.f[i], b.f[i]); return r; }
+	static reg Abs(const reg a)					{ reg r; for(int i = 0; i < W; ++i) r.f[i] = qAbs(a.f[i]); return r; }
+	static reg Sqrt(const reg a)				{ reg r; for(int i = 0; i < W; ++i) r.f[i] = sqrtf(a.f[i]); return r; }
+	
+	static reg MulAdd(const reg a, const reg b, const reg c)
+	{
+		reg r;
+		for(int i = 0; i < W; ++i) r.f[i] = a.f[i] * b.f[i] + c.f[i];
+		return r;
+	}
+	
+	static mask CmpLt(const reg a, const reg b)	{ mask r; for(int i = 0; i < W; ++i) r.m[i] = (a.f[i] < b.f[i]) ? ~0u : 0u; return r; }
+	static mask CmpLe(const reg a, const reg b)	{ mask r; for(int i = 0; i < W; ++i) r.m[i] = (a.f[i] <= b.f[i]) ? ~0u : 0u; return r; }
+	static mask CmpGt(const reg a, const reg b)	{ mask r; for(int i = 0; i < W; ++i) r.m[i] = (a.f[i] > b.f[i]) ? ~0u : 0u; return r; }
+	static mask CmpGe(const reg a, const reg b)	{ mask r; for(int i = 0; i < W; ++i) r.m[i] = (a.f[i] >= b.f[i]) ? ~0u : 0u; return r; }
+	static mask CmpEq(const reg a, const reg b)	{ mask r; for(int i = 0; i < W; ++i) r.m[i] = (a.f[i] == b.f[i]) ? ~0u : 0u; return r; }
+	static mask CmpNeq(const reg a, const reg b)	{ mask r; for(int i = 0; i < W; ++i) r.m[i] = (a.f[i] != b.f[i]) ? ~0u : 0u; return r; }
+	
+	static mask And(const mask a, const mask b)	{ mask r; for(int i = 0; i < W; ++i) r.m[i] = a.m[i] & b.m[i]; return r; }
+	static mask Or(const mask a, const mask b)	{ mask r; for(int i = 0; i < W; ++i) r.m[i] = a.m[i] | b.m[i]; return r; }
+	static mask Xor(const mask a, const mask b)	{ mask r; for(int i = 0; i < W; ++i) r.m[i] = a.m[i] ^ b.m[i]; return r; }
+	static mask Not(const mask a)				{ mask r; for(int i = 0; i < W; ++i) r.m[i] = ~a.m[i]; return r; }
+	
+	static int MaskBits(const mask a)
+	{
+		int bits = 0;
+		for(int i = 0; i < W; ++i) bits |= (a.m[i] & 1) << i;
+		return bits;
+	}
+	
+	static reg Select(const mask m, const reg a, const reg b)
+	{
+		reg r;
+		for(int i = 0; i < W; ++i) r.f[i] = m.m[i] ? a.f[i] : b.f[i];
+		return r;
+	}
+	
+	static float HorizontalAdd(const reg a)		{ float r = a.f[0]; for(int i = 1; i < W; ++i) r += a.f[i]; return r; }
+	static float HorizontalMin(const reg a)		{ float r = a.f[0]; for(int i = 1; i < W; ++i) r = qMin(r, a.f[i]); return r; }
+	static float HorizontalMax(const reg a)		{ float r = a.f[0]; for(int i = 1; i < W; ++i) r = qMax(r, a.f[i]); return r; }
+	
+	//W packed 3 component vectors to and from x, y, z lanes
+	static void Load3(const float* p, reg &x, reg &y, reg &z)
+	{
+		for(int i = 0; i < W; ++i)
+		{
+			x.f[i] = p[i * 3 + 0];
+			y.f[i] = p[i * 3 + 1];
+			z.f[i] = p[i * 3 + 2];
+		}
+	}
+	
+	static void Store3(float* p, const reg x, const reg y, const reg z)
+	{
+		for(int i = 0; i < W; ++i)
+		{
+			p[i * 3 + 0] = x.f[i];
+			p[i * 3 + 1] = y.f[i];
+			p[i * 3 + 2] = z.f[i];
+		}
+	}
+};
+
+#if qSIMD_ENABLED
+template<>
+struct qPacketOps<4>
+{
+	typedef qSIMD::float4 reg;
+	typedef qSIMD::mask4 mask;
+	
+	static reg Load(const float* p)							{ return qSIMD::Load(p); }
+	static void Store(float* p, const reg a)				{ qSIMD::Store(p, a); }
+	static reg Splat(const float f)							{ return qSIMD::Splat(f); }
+	static reg Add(const reg a, const reg b)				{ return qSIMD::Add(a, b); }
+	static reg Sub(const reg a, const reg b)				{ return qSIMD::Sub(a, b); }
+	static reg Mul(const reg a, const reg b)				{ return qSIMD::Mul(a, b); }
+	static reg Div(const reg a, const reg b)				{ return qSIMD::Div(a, b); }
+	static reg Min(const reg a, const reg b)				{ return qSIMD::Min(a, b); }
+	static reg Max(const reg a, const reg b)				{ return qSIMD::Max(a, b); }
+	static reg Abs(const reg a)								{ return qSIMD::Abs(a); }
+	static reg Sqrt(const reg a)							{ return qSIMD::Sqrt(a); }
+	static reg MulAdd(const reg a, const reg b, const reg c)	{ return qSIMD::MulAdd(a, b, c); }
+	static mask CmpLt(const reg a, const reg b)				{ return qSIMD::CmpLt(a, b); }
+	static mask CmpLe(const reg a, const reg b)				{ return qSIMD::CmpLe(a, b); }
+	static mask CmpGt(const reg a, const reg b)				{ return qSIMD::CmpGt(a, b); }
+	static mask CmpGe(const reg a, const reg b)				{ return qSIMD::CmpGe(a, b); }
+	static mask CmpEq(const reg a, const reg b)				{ return qSIMD::CmpEq(a, b); }
+	static mask CmpNeq(const reg a, const reg b)			{ return qSIMD::CmpNeq(a, b); }
+	static mask And(const mask a, const mask b)				{ return qSIMD::And(a, b); }
+	static mask Or(const mask a, const mask b)				{ return qSIMD::Or(a, b); }
+	static mask Xor(const mask a, const mask b)				{ return qSIMD::Xor(a, b); }
+	static mask Not(const mask a)							{ return qSIMD::Not(a); }
+	static int MaskBits(const mask a)						{ return qSIMD::MaskBits(a); }
+	static reg Select(const mask m, const reg a, const reg b)	{ return qSIMD::Select(m, a, b); }
+	static float HorizontalAdd(const reg a)					{ return qSIMD::HorizontalAdd(a); }
+	static float HorizontalMin(const reg a)					{ return qSIMD::HorizontalMin(a); }
+	static float HorizontalMax(const reg a)					{ return qSIMD::HorizontalMax(a); }
+	static void Load3(const float* p, reg &x, reg &y, reg &z)	{ qSIMD::Load3x4(p, x, y, z); }
+	static void Store3(float* p, const reg x, const reg y, const reg z)	{ qSIMD::Store3x4(p, x, y, z); }
+};
+#endif
+
+#if qSIMD_AVX
+template<>
+struct qPacketOps<8>
+{
+	typedef qSIMD::float8 reg;
+	typedef qSIMD::mask8 mask;
+	
+	static reg Load(const float* p)							{ return qSIMD::Load8(p); }
+	static void Store(float* p, const reg a)				{ qSIMD::Store(p, a); }
+	static reg Splat(const float f)							{ return qSIMD::Splat8(f); }
+	static reg Add(const reg a, const reg b)				{ return qSIMD::Add(a, b); }
+	static reg Sub(const reg a, const reg b)				{ return qSIMD::Sub(a, b); }
+	static reg Mul(const reg a, const reg b)				{ return qSIMD::Mul(a, b); }
+	static reg Div(const reg a, const reg b)				{ return qSIMD::Div(a, b); }
+	static reg Min(const reg a, const reg b)				{ return qSIMD::Min(a, b); }
+	static reg Max(const reg a, const reg b)				{ return qSIMD::Max(a, b); }
+	static reg Abs(const reg a)								{ return qSIMD::Abs(a); }
+	static reg Sqrt(const reg a)							{ return qSIMD::Sqrt(a); }
+	static reg MulAdd(const reg a, const reg b, const reg c)	{ return qSIMD::MulAdd(a, b, c); }
+	static mask CmpLt(const reg a, const reg b)				{ return qSIMD::CmpLt(a, b); }
+	static mask CmpLe(const reg a, const reg b)				{ return qSIMD::CmpLe(a, b); }
+	static mask CmpGt(const reg a, const reg b)				{ return qSIMD::CmpGt(a, b); }
+	static mask CmpGe(const reg a, const reg b)				{ return qSIMD::CmpGe(a, b); }
+	static mask CmpEq(const reg a, const reg b)				{ return qSIMD::CmpEq(a, b); }
+	static mask CmpNeq(const reg a, const reg b)			{ return qSIMD::CmpNeq(a, b); }
+	static mask And(const mask a, const mask b)				{ return qSIMD::And(a, b); }
+	static mask Or(const mask a, const mask b)				{ return qSIMD::Or(a, b); }
+	static mask Xor(const mask a, const mask b)				{ return qSIMD::Xor(a, b); }
+	static mask Not(const mask a)							{ return qSIMD::Not(a); }
+	static int MaskBits(const mask a)						{ return qSIMD::MaskBits(a); }
+	static reg Select(const mask m, const reg a, const reg b)	{ return qSIMD::Select(m, a, b); }
+	static float HorizontalAdd(const reg a)					{ return qSIMD::HorizontalAdd(a); }
+	static float HorizontalMin(const reg a)					{ return qSIMD::HorizontalMin(a); }
+	static float HorizontalMax(const reg a)					{ return qSIMD::HorizontalMax(a); }
+	
+	static void Load3(const float* p, reg &x, reg &y, reg &z)
+	{
+		qSIMD::float4 x0, y0, z0, x1, y1, z1;
+		qSIMD::Load3x4(p, x0, y0, z0);
+		qSIMD::Load3x4(p + 12, x1, y1, z1);
+		x = _mm256_insertf128_ps(_mm256_castps128_ps256(x0), x1, 1);
+		y = _mm256_insertf128_ps(_mm256_castps128_ps256(y0), y1, 1);
+		z = _mm256_insertf128_ps(_mm256_castps128_ps256(z0), z1, 1);
+	}
+	
+	static void Store3(float* p, const reg x, const reg y, const reg z)
+	{
+		qSIMD::Store3x4(p, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+		qSIMD::Store3x4(p + 12, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+	}
+};
+#endif
+
+#pragma mark mask
+
+template<int W>
+class qMaskx_T
+{
+public:
+	
+	typedef qPacketOps<W> Ops;
+	
+	typename Ops::mask m;
+	
+	qMaskx_T()
+	{}
+	
+	explicit qMaskx_T(const typename Ops::mask _m)
+	: m(_m)
+	{}
+	
+#pragma mark getters
+	
+	bool operator[](int lane) const
+	{
+		qASSERT(lane < W);
+		return (Bits() >> lane) & 1;
+	}
+	
+	//lane i in bit i
+	int Bits() const
+	{
+		return Ops::MaskBits(m);
+	}
+	
+	bool Any() const
+	{
+		return Bits() != 0;
+	}
+	
+	bool All() const
+	{
+		return Bits() == (1 << W) - 1;
+	}
+	
+	bool None() const
+	{
+		return Bits() == 0;
+	}
+	
+#pragma mark logic
+	
+	qMaskx_T operator&(const qMaskx_T &rhs) const
+	{
+		return qMaskx_T(Ops::And(m, rhs.m));
+	}
+	
+	qMaskx_T operator|(const qMaskx_T &rhs) const
+	{
+		return qMaskx_T(Ops::Or(m, rhs.m));
+	}
+	
+	qMaskx_T operator^(const qMaskx_T &rhs) const
+	{
+		return qMaskx_T(Ops::Xor(m, rhs.m));
+	}
+	
+	qMaskx_T operator~() const
+	{
+		return qMaskx_T(Ops::Not(m));
+	}
+};
+
+#pragma mark float
+
+template<int W>
+class qFloatx_T
+{
+public:
+	
+	typedef qPacketOps<W> Ops;
+	
+	typename Ops::reg r;
+	
+	//uninitialised, like any other register
+	qFloatx_T()
+	{}
+	
+	qFloatx_T(const float f)
+	: r(Ops::Splat(f))
+	{}
+	
+	explicit qFloatx_T(const typename Ops::reg _r)
+	: r(_r)
+	{}
+	
+	static qFloatx_T Load(const float* p)
+	{
+		return qFloatx_T(Ops::Load(p));
+	}
+	
+	void Store(float* p) const
+	{
+		Ops::Store(p, r);
+	}
+	
+#pragma mark getters
+	
+	float operator[](int lane) const
+	{
+		qASSERT(lane < W);
+		float lanes[W];
+		Ops::Store(lanes, r);
+		return lanes[lane];
+	}
+	
+#pragma mark arithmetic
+	
+	qFloatx_T operator+(const qFloatx_T &rhs) const		{ return qFloatx_T(Ops::Add(r, rhs.r)); }
+	qFloatx_T operator-(const qFloatx_T &rhs) const		{ return qFloatx_T(Ops::Sub(r, rhs.r)); }
+	qFloatx_T operator*(const qFloatx_T &rhs) const		{ return qFloatx_T(Ops::Mul(r, rhs.r)); }
+	qFloatx_T operator/(const qFloatx_T &rhs) const		{ return qFloatx_T(Ops::Div(r, rhs.r)); }
+	qFloatx_T operator-() const							{ return qFloatx_T(Ops::Sub(Ops::Splat(0.0f), r)); }
+	
+	qFloatx_T& operator+=(const qFloatx_T &rhs)			{ r = Ops::Add(r, rhs.r); return *this; }
+	qFloatx_T& operator-=(const qFloatx_T &rhs)			{ r = Ops::Sub(r, rhs.r); return *this; }
+	qFloatx_T& operator*=(const qFloatx_T &rhs)			{ r = Ops::Mul(r, rhs.r); return *this; }
+	qFloatx_T& operator/=(const qFloatx_T &rhs)			{ r = Ops::Div(r, rhs.r); return *this; }
+	
+#pragma mark comparison
+	
+	qMaskx_T<W> operator<(const qFloatx_T &rhs) const	{ return qMaskx_T<W>(Ops::CmpLt(r, rhs.r)); }
+	qMaskx_T<W> operator<=(const qFloatx_T &rhs) const	{ return qMaskx_T<W>(Ops::CmpLe(r, rhs.r)); }
+	qMaskx_T<W> operator>(const qFloatx_T &rhs) const	{ return qMaskx_T<W>(Ops::CmpGt(r, rhs.r)); }
+	qMaskx_T<W> operator>=(const qFloatx_T &rhs) const	{ return qMaskx_T<W>(Ops::CmpGe(r, rhs.r)); }
+	qMaskx_T<W> operator==(const qFloatx_T &rhs) const	{ return qMaskx_T<W>(Ops::CmpEq(r, rhs.r)); }
+	qMaskx_T<W> operator!=(const qFloatx_T &rhs) const	{ return qMaskx_T<W>(Ops::CmpNeq(r, rhs.r)); }
+	
+#pragma mark util
+	
+	float HorizontalAdd() const
+	{
+		return Ops::HorizontalAdd(r);
+	}
+	
+	float HorizontalMin() const
+	{
+		return Ops::HorizontalMin(r);
+	}
+	
+	float HorizontalMax() const
+	{
+		return Ops::HorizontalMax(r);
+	}
+	
+	//a * b + c, fused where the target allows
+	static qFloatx_T MulAdd(const qFloatx_T &a, const qFloatx_T &b, const qFloatx_T &c)
+	{
+		return qFloatx_T(Ops::MulAdd(a.r, b.r, c.r));
+	}
+	
+	static qFloatx_T Sqrt(const qFloatx_T &a)
+	{
+		return qFloatx_T(Ops::Sqrt(a.r));
+	}
+	
+	static qFloatx_T Abs(const qFloatx_T &a)
+	{
+		return qFloatx_T(Ops::Abs(a.r));
+	}
+	
+	static qFloatx_T Max(const qFloatx_T &a, const qFloatx_T &b)
+	{
+		return qFloatx_T(Ops::Max(a.r, b.r));
+	}
+	
+	static qFloatx_T Min(const qFloatx_T &a, const qFloatx_T &b)
+	{
+		return qFloatx_T(Ops::Min(a.r, b.r));
+	}
+	
+	//lanes of a where mask is set, otherwise lanes of b
+	static qFloatx_T Select(const qMaskx_T<W> &mask, const qFloatx_T &a, const qFloatx_T &b)
+	{
+		return qFloatx_T(Ops::Select(mask.m, a.r, b.r));
+	}
+};
+
+typedef qFloatx_T<4> qFloatx4;
+typedef qFloatx_T<8> qFloatx8;
+typedef qFloatx_T<qPACKET_WIDTH> qFloatxN;
+
+typedef qMaskx_T<4> qMaskx4;
+typedef qMaskx_T<8> qMaskx8;
+typedef qMaskx_T<qPACKET_WIDTH> qMaskxN;
+
+#endif // __Q_PACKET_H__
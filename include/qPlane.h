@@ -25,6 +25,7 @@ SOFTWARE.
 
 #include "qCore.h"
 #include "qVector3.h"
+#include <type_traits>
 
 template<typename T, int ALIGN>
 class qPlane_T
@@ -40,15 +41,16 @@ public:
 		Update(_normal, _origin);
 	}
 	
-    qPlane_T(const qPlane_T &p)
-    : normal(p.normal)
-    , origin(p.origin)
-    , d(p.d)
-    {}
-    
-    ~qPlane_T()
-    {}
-    
+	//the plane a * x + b * y + c * z + d = 0, scaled to a unit normal
+	static qPlane_T FromCoefficients(T a, T b, T c, T d)
+	{
+		qVector3_T<T, ALIGN> n(a, b, c);
+		T length = n.Length();
+		qASSERT(length > T(0));
+		n = n * (T(1) / length);
+		return qPlane_T(n, n * (-d / length));
+	}
+	
 #pragma mark setters
 
 	void Update(qVector3_T<T, ALIGN> _normal, qVector3_T<T, ALIGN> _origin)
@@ -59,16 +61,6 @@ public:
 		d = T(-1.0) * qVector3_T<T, ALIGN>::Dot(normal, origin);
 	}
     
-#pragma mark assignment
-    
-    qPlane_T& operator=(const qPlane_T &rhs)
-    { 
-        normal = rhs.normal;
-        origin = rhs.origin;
-        d = rhs.d;
-        return *this;
-    }
-	
 #pragma mark util
 
 	T Distance(qVector3_T<T, ALIGN> point)
@@ -76,6 +68,12 @@ public:
 		return std::abs(qVector3_T<T, ALIGN>::Dot(normal, point) + d);
 	}
 	
+	//positive on the side the normal faces
+	T SignedDistance(const qVector3_T<T, ALIGN> &point) const
+	{
+		return qVector3_T<T, ALIGN>::Dot(normal, point) + d;
+	}
+	
 	qVector3_T<T, ALIGN> Location(T x, T y)
 	{
 		T z = -d - normal.x * x - normal.y * y;
@@ -99,4 +97,11 @@ typedef qPlane_T<double, 8> qPlaned;
 typedef qPlane_T<float, 4> qPlane;
 typedef qPlane_T<half, 2> qPlaneh;
 
+static_assert(std::is_trivially_copyable<qPlaned>::value, "qPlaned must be trivially copyable");
+static_assert(std::is_standard_layout<qPlaned>::value, "qPlaned must be standard layout");
+static_assert(std::is_trivially_copyable<qPlane>::value, "qPlane must be trivially copyable");
+static_assert(std::is_standard_layout<qPlane>::value, "qPlane must be standard layout");
+static_assert(std::is_trivially_copyable<qPlaneh>::value, "qPlaneh must be trivially copyable");
+static_assert(std::is_standard_layout<qPlaneh>::value, "qPlaneh must be standard layout");
+
 #endif // __Q_PLANE_H__
@@ -26,6 +26,7 @@ SOFTWARE.
 #include "qCore.h"
 #include "qVector4.h"
 #include <iostream>
+#include <type_traits>
 
 template<typename T, int ALIGN>
 class qQuad_T
@@ -45,30 +46,20 @@ public:
         T q[4];
     };
     
-    qQuad_T(T _a, T _b, T _c, T _d)
+    constexpr qQuad_T(T _a, T _b, T _c, T _d)
     : a(_a)
     , b(_b)
     , c(_c)
     , d(_d)
     {}
 	
-    qQuad_T(const qQuad_T& quad)
-    : a(quad.a)
-    , b(quad.b)
-    , c(quad.c)
-    , d(quad.d)
-    {}
-    
-    qQuad_T()
+    constexpr qQuad_T()
     : a(T(0))
     , b(T(0))
     , c(T(0))
     , d(T(0))
     {}
     
-    ~qQuad_T()
-    {}
-
 #pragma mark getters
     
     T operator[](int pos) const
@@ -77,17 +68,6 @@ public:
         return q[pos];
     }
     
-#pragma mark assignment
-    
-    qQuad_T& operator=(const qQuad_T &rhs)
-    { 
-        a = rhs.a;
-        b = rhs.b;
-        c = rhs.c;
-        d = rhs.d;
-        return *this;
-    }
-    
 #pragma mark util
     
 	friend std::ostream& operator<<(std::ostream& out, const qQuad_T& quad)
@@ -109,4 +89,14 @@ typedef qQuad_T<qVector4d, 8> 	qQuad4d;
 typedef qQuad_T<qVector4, 4> 	qQuad4;
 typedef qQuad_T<qVector4h, 2> 	qQuad4h;
 
+static_assert(std::is_trivially_copyable<qQuad2>::value, "qQuad2 must be trivially copyable");
+static_assert(std::is_standard_layout<qQuad2>::value, "qQuad2 must be standard layout");
+static_assert(sizeof(qQuad2) == 4 * sizeof(qVector2), "qQuad2 must be tightly packed");
+static_assert(std::is_trivially_copyable<qQuad3>::value, "qQuad3 must be trivially copyable");
+static_assert(std::is_standard_layout<qQuad3>::value, "qQuad3 must be standard layout");
+static_assert(sizeof(qQuad3) == 4 * sizeof(qVector3), "qQuad3 must be tightly packed");
+static_assert(std::is_trivially_copyable<qQuad4>::value, "qQuad4 must be trivially copyable");
+static_assert(std::is_standard_layout<qQuad4>::value, "qQuad4 must be standard layout");
+static_assert(sizeof(qQuad4) == 4 * sizeof(qVector4), "qQuad4 must be tightly packed");
+
 #endif // __Q_QUAD_H__
@@ -27,6 +27,7 @@ SOFTWARE.
 #include "qUtil.h"
 #include "qCore.h"
 #include <iostream>
+#include <type_traits>
 
 template<typename T>
 class qRGBA
@@ -45,35 +46,35 @@ public:
         T rgba[4];
     };
     
-    qRGBA(T _r, T _g, T _b, T _a)
+    constexpr qRGBA(T _r, T _g, T _b, T _a)
 	: r(_r)
 	, g(_g)
 	, b(_b)
 	, a(_a)
 	{}
 
-    qRGBA(T _r, T _g, T _b)
+    constexpr qRGBA(T _r, T _g, T _b)
 	: r(_r)
 	, g(_g)
 	, b(_b)
 	, a(T(1))
 	{}
 	
-    qRGBA(T grayscale, T _a)
+    constexpr qRGBA(T grayscale, T _a)
 	: r(grayscale)
 	, g(grayscale)
 	, b(grayscale)
 	, a(_a)
 	{}
 	
-    qRGBA(T grayscale)
+    constexpr qRGBA(T grayscale)
 	: r(grayscale)
 	, g(grayscale)
 	, b(grayscale)
 	, a(T(1))
 	{}
     
-    qRGBA()
+    constexpr qRGBA()
 	: r(T(0))
 	, g(T(0))
 	, b(T(0))
@@ -92,17 +93,6 @@ public:
 		return rgba[pos];
 	}
     
-#pragma mark assignment
-    
-    qRGBA& operator=(const qRGBA &rhs)
-	{
-		r = rhs.r;
-		g = rhs.g;
-		b = rhs.b;
-		a = rhs.a;
-		return *this;
-	}
-    
 #pragma mark comparison
     
     bool operator==(const qRGBA &rhs) const
@@ -327,16 +317,26 @@ typedef qRGBA<uint8_t> qRGBA8;
 typedef qRGBA<half> qRGBA16f;
 typedef qRGBA<float> qRGBA32f;
 
-const qRGBA<uint8_t> qRGBA8_Transparent(0, 0, 0, 0);
-const qRGBA<uint8_t> qRGBA8_Black(0, 0, 0, 1);
-const qRGBA<uint8_t> qRGBA8_White(255, 255, 255, 255);
+static_assert(std::is_trivially_copyable<qRGBA8>::value, "qRGBA8 must be trivially copyable");
+static_assert(std::is_standard_layout<qRGBA8>::value, "qRGBA8 must be standard layout");
+static_assert(sizeof(qRGBA8) == 4 * sizeof(uint8_t), "qRGBA8 must be tightly packed");
+static_assert(std::is_trivially_copyable<qRGBA16f>::value, "qRGBA16f must be trivially copyable");
+static_assert(std::is_standard_layout<qRGBA16f>::value, "qRGBA16f must be standard layout");
+static_assert(sizeof(qRGBA16f) == 4 * sizeof(half), "qRGBA16f must be tightly packed");
+static_assert(std::is_trivially_copyable<qRGBA32f>::value, "qRGBA32f must be trivially copyable");
+static_assert(std::is_standard_layout<qRGBA32f>::value, "qRGBA32f must be standard layout");
+static_assert(sizeof(qRGBA32f) == 4 * sizeof(float), "qRGBA32f must be tightly packed");
+
+constexpr qRGBA<uint8_t> qRGBA8_Transparent(0, 0, 0, 0);
+constexpr qRGBA<uint8_t> qRGBA8_Black(0, 0, 0, 1);
+constexpr qRGBA<uint8_t> qRGBA8_White(255, 255, 255, 255);
 
-const qRGBA<half> qRGBA32h_Transparent(0.0, 0.0, 0.0, 0.0);
-const qRGBA<half> qRGBA32h_Black(0.0, 0.0, 0.0, 1.0);
-const qRGBA<half> qRGBA32h_White(1.0, 1.0, 1.0, 1.0);
+constexpr qRGBA<half> qRGBA32h_Transparent(0.0, 0.0, 0.0, 0.0);
+constexpr qRGBA<half> qRGBA32h_Black(0.0, 0.0, 0.0, 1.0);
+constexpr qRGBA<half> qRGBA32h_White(1.0, 1.0, 1.0, 1.0);
 
-const qRGBA<float> qRGBA32f_Transparent(0.0f, 0.0f, 0.0f, 0.0f);
-const qRGBA<float> qRGBA32f_Black(0.0f, 0.0f, 0.0f, 1.0f);
-const qRGBA<float> qRGBA32f_White(1.0f, 1.0f, 1.0f, 1.0f);
+constexpr qRGBA<float> qRGBA32f_Transparent(0.0f, 0.0f, 0.0f, 0.0f);
+constexpr qRGBA<float> qRGBA32f_Black(0.0f, 0.0f, 0.0f, 1.0f);
+constexpr qRGBA<float> qRGBA32f_White(1.0f, 1.0f, 1.0f, 1.0f);
 
 #endif // __Q_RGBA_H__
@@ -27,80 +27,548 @@ SOFTWARE.
 #include "qVector3.h"
 #include "qVector4.h"
 #include "qRGBA.h"
+#include "qRandomEngine.h"
+#include "qRandomCounter.h"
+#include "qParallel.h"
+#include <vector>
 
+//reseeds the calling thread's engine and every thread engine created after it; 0 seeds from the clock
 void qSeedRandom(int seed = 0);
 
-NSUInteger qRandom(const NSUInteger max);
-NSUInteger qRandom(const NSUInteger min, const NSUInteger max);
+#pragma mark explicit engine
+
+NSUInteger qRandom(qRandomEngine &engine, const NSUInteger max);
+NSUInteger qRandom(qRandomEngine &engine, const NSUInteger min, const NSUInteger max);
 
 template<class T>
-T qRandom(const T max)
+T qRandom(qRandomEngine &engine, const T max)
 {
-	float rand01 = float(rand()) / float(RAND_MAX);
+	float rand01 = engine.NextFloat();
 	T result = float(max) * rand01;
     return T(result);
 }
 
 template<class T>
-T qRandom(const T min, const T max)
+T qRandom(qRandomEngine &engine, const T min, const T max)
 {
 	qASSERT(max >= min);
-	T offset = qRandom<T>(max - min);
+	T offset = qRandom<T>(engine, max - min);
 	return min + offset;
 }
 
 template<typename T, int ALIGN>
-qVector2_T<T, ALIGN> qRandom(const qVector2_T<T, ALIGN> min, const qVector2_T<T, ALIGN> max)
+qVector2_T<T, ALIGN> qRandom(qRandomEngine &engine, const qVector2_T<T, ALIGN> min, const qVector2_T<T, ALIGN> max)
 {
     qVector2_T<T, ALIGN> result;
-    result.x = qRandom(min.x, max.x);
-    result.y = qRandom(min.y, max.y);
+    result.x = qRandom(engine, min.x, max.x);
+    result.y = qRandom(engine, min.y, max.y);
     return result;
 }
 
 template<typename T, int ALIGN>
-qVector3_T<T, ALIGN> qRandom(const qVector3_T<T, ALIGN> min, const qVector3_T<T, ALIGN> max)
+qVector3_T<T, ALIGN> qRandom(qRandomEngine &engine, const qVector3_T<T, ALIGN> min, const qVector3_T<T, ALIGN> max)
 {
     qVector3_T<T, ALIGN> result;
-    result.x = qRandom(min.x, max.x);
-    result.y = qRandom(min.y, max.y);
-    result.z = qRandom(min.z, max.z);
+    result.x = qRandom(engine, min.x, max.x);
+    result.y = qRandom(engine, min.y, max.y);
+    result.z = qRandom(engine, min.z, max.z);
     return result;
 }
 
 template<typename T, int ALIGN>
-qVector4_T<T, ALIGN> qRandom(const qVector4_T<T, ALIGN> min, const qVector4_T<T, ALIGN> max)
+qVector4_T<T, ALIGN> qRandom(qRandomEngine &engine, const qVector4_T<T, ALIGN> min, const qVector4_T<T, ALIGN> max)
 {
     qVector4_T<T, ALIGN> result;
-	result.x = qRandom(min.x, max.x);
-	result.y = qRandom(min.y, max.y);
-	result.z = qRandom(min.z, max.z);
-	result.w = qRandom(min.w, max.w);
+	result.x = qRandom(engine, min.x, max.x);
+	result.y = qRandom(engine, min.y, max.y);
+	result.z = qRandom(engine, min.z, max.z);
+	result.w = qRandom(engine, min.w, max.w);
     return result;
 }
 
 template<class T>
-qRGBA<T> qRandom(const qRGBA<T> min, const qRGBA<T> max)
+qRGBA<T> qRandom(qRandomEngine &engine, const qRGBA<T> min, const qRGBA<T> max)
 {
     qRGBA<T> result;
-    result.r = qRandom(min.r, max.r);
-    result.g = qRandom(min.g, max.g);
-    result.b = qRandom(min.b, max.b);
-    result.a = qRandom(min.a, max.a);
+    result.r = qRandom(engine, min.r, max.r);
+    result.g = qRandom(engine, min.g, max.g);
+    result.b = qRandom(engine, min.b, max.b);
+    result.a = qRandom(engine, min.a, max.a);
     return result;
 }
 
-float qRandomGaussian(const float mean, const float stdDev);
+//normal draws from a ziggurat; almost every value costs one random word and one table compare
+float qRandomGaussian(qRandomEngine &engine);
+float qRandomGaussian(qRandomEngine &engine, const float mean, const float stdDev);
+
+//normal draws restricted to [min, max] by inverse cdf; always one random word and a fixed amount of math, however narrow the bounds.
+//the bounds cost two erf calls, so keep one of these around when drawing many values with the same shape
+struct qTruncatedGaussian
+{
+	float mean;
+	float stdDev;
+	float min;
+	float max;
+	float lo;
+	float hi;
+	
+	qTruncatedGaussian(const float _mean, const float _stdDev, const float _min, const float _max);
+	
+	float Sample(qRandomEngine &engine) const;
+	void Fill(qRandomEngine &engine, float* out, const int count) const;
+};
+
+float qRandomTruncatedGaussian(qRandomEngine &engine, const float mean, const float stdDev, const float min, const float max);
 
-int qRandomInt(const int count);
+inline int qRandomInt(qRandomEngine &engine, const int count)
+{
+	qASSERT(count > 0);
+	return int(engine.NextBounded(uint32_t(count)));
+}
 
-bool qRandomBool();
+inline bool qRandomBool(qRandomEngine &engine)
+{
+	return (engine.Next() >> 63) != 0;
+}
+
+template <class TYPE>
+TYPE qPick(qRandomEngine &engine, const TYPE* list, const int listLength)
+{
+    return list[qRandomInt(engine, listLength)];
+}
+
+#pragma mark batch
+
+//count values in the same ranges as qRandom, generated several streams at a time; spans under a few dozen values use the engine directly
+void qRandomFill01(qRandomEngine &engine, float* out, const int count);
+void qRandomFill(qRandomEngine &engine, float* out, const int count, const float min, const float max);
+void qRandomFill(qRandomEngine &engine, int* out, const int count, const int min, const int max);
+void qRandomFillGaussian(qRandomEngine &engine, float* out, const int count, const float mean, const float stdDev);
+
+//count packed elements of N components, component k in [min[k], max[k])
+template<int N, typename T>
+void qRandomFillComponents(qRandomEngine &engine, T* out, const int count, const T* min, const T* max)
+{
+	const int chunk = 256 / N;
+	float unit[chunk * N];
+	for(int base = 0; base < count; base += chunk)
+	{
+		const int elements = qMin(chunk, count - base);
+		qRandomFill01(engine, unit, elements * N);
+		for(int i = 0; i < elements; ++i)
+		{
+			for(int k = 0; k < N; ++k)
+			{
+				out[(base + i) * N + k] = min[k] + T(float(max[k] - min[k]) * unit[i * N + k]);
+			}
+		}
+	}
+}
+
+//maps count packed elements of N components from [0, 1) to [min[k], max[k]) in place
+template<int N>
+void qRandomRemapComponents(float* out, const int count, const float* min, const float* max)
+{
+	//the component pattern repeats every 16 * N floats, so the remap runs over whole registers with no per-element index math
+	const int period = 16 * N;
+	float offset[period];
+	float range[period];
+	for(int j = 0; j < period; ++j)
+	{
+		offset[j] = min[j % N];
+		range[j] = max[j % N] - min[j % N];
+	}
+	
+	const int total = count * N;
+	int base = 0;
+	for(; base + period <= total; base += period)
+	{
+		for(int j = 0; j < period; ++j)
+		{
+			out[base + j] = offset[j] + out[base + j] * range[j];
+		}
+	}
+	
+	for(int j = 0; base + j < total; ++j)
+	{
+		out[base + j] = offset[j] + out[base + j] * range[j];
+	}
+}
+
+template<int N>
+void qRandomFillComponents(qRandomEngine &engine, float* out, const int count, const float* min, const float* max)
+{
+	qRandomFill01(engine, out, count * N);
+	qRandomRemapComponents<N>(out, count, min, max);
+}
+
+template<typename T, int ALIGN>
+void qRandomFill(qRandomEngine &engine, qVector2_T<T, ALIGN>* out, const int count, const qVector2_T<T, ALIGN> min, const qVector2_T<T, ALIGN> max)
+{
+	if(count > 0)
+	{
+		qRandomFillComponents<2>(engine, out[0].v, count, min.v, max.v);
+	}
+}
+
+template<typename T, int ALIGN>
+void qRandomFill(qRandomEngine &engine, qVector3_T<T, ALIGN>* out, const int count, const qVector3_T<T, ALIGN> min, const qVector3_T<T, ALIGN> max)
+{
+	if(count > 0)
+	{
+		qRandomFillComponents<3>(engine, out[0].v, count, min.v, max.v);
+	}
+}
+
+template<typename T, int ALIGN>
+void qRandomFill(qRandomEngine &engine, qVector4_T<T, ALIGN>* out, const int count, const qVector4_T<T, ALIGN> min, const qVector4_T<T, ALIGN> max)
+{
+	if(count > 0)
+	{
+		qRandomFillComponents<4>(engine, out[0].v, count, min.v, max.v);
+	}
+}
+
+template<class T>
+void qRandomFill(qRandomEngine &engine, qRGBA<T>* out, const int count, const qRGBA<T> min, const qRGBA<T> max)
+{
+	if(count > 0)
+	{
+		qRandomFillComponents<4>(engine, out[0].rgba, count, min.rgba, max.rgba);
+	}
+}
+
+#pragma mark counter
+
+//scalars and ints share blocks, sixty four indices to sixteen blocks; vectors and colours take component k from word k of block index
+
+template<class T>
+T qRandom(const qRandomCounter &counter, const uint64_t stream, const uint64_t index, const T min, const T max)
+{
+	qASSERT(max >= min);
+	return min + T(float(max - min) * counter.NextFloat(stream, index));
+}
+
+//ints by multiply-shift; a stateless draw can't reject, so the bias is at most range / 2^32
+inline int qRandom(const qRandomCounter &counter, const uint64_t stream, const uint64_t index, const int min, const int max)
+{
+	qASSERT(max >= min);
+	const uint64_t range = uint64_t(int64_t(max) - int64_t(min));
+	return int(int64_t(min) + int64_t((uint64_t(counter.Next32(stream, index)) * range) >> 32));
+}
+
+inline int qRandomInt(const qRandomCounter &counter, const uint64_t stream, const uint64_t index, const int count)
+{
+	qASSERT(count > 0);
+	return qRandom(counter, stream, index, 0, count);
+}
+
+template<typename T, int ALIGN>
+qVector2_T<T, ALIGN> qRandom(const qRandomCounter &counter, const uint64_t stream, const uint64_t index, const qVector2_T<T, ALIGN> min, const qVector2_T<T, ALIGN> max)
+{
+	uint32_t words[4];
+	counter.GenerateComponents(stream, index, words);
+	qVector2_T<T, ALIGN> result;
+	result.x = min.x + T(float(max.x - min.x) * qRandomCounter::ToFloat(words[0]));
+	result.y = min.y + T(float(max.y - min.y) * qRandomCounter::ToFloat(words[1]));
+	return result;
+}
+
+template<typename T, int ALIGN>
+qVector3_T<T, ALIGN> qRandom(const qRandomCounter &counter, const uint64_t stream, const uint64_t index, const qVector3_T<T, ALIGN> min, const qVector3_T<T, ALIGN> max)
+{
+	uint32_t words[4];
+	counter.GenerateComponents(stream, index, words);
+	qVector3_T<T, ALIGN> result;
+	result.x = min.x + T(float(max.x - min.x) * qRandomCounter::ToFloat(words[0]));
+	result.y = min.y + T(float(max.y - min.y) * qRandomCounter::ToFloat(words[1]));
+	result.z = min.z + T(float(max.z - min.z) * qRandomCounter::ToFloat(words[2]));
+	return result;
+}
+
+template<typename T, int ALIGN>
+qVector4_T<T, ALIGN> qRandom(const qRandomCounter &counter, const uint64_t stream, const uint64_t index, const qVector4_T<T, ALIGN> min, const qVector4_T<T, ALIGN> max)
+{
+	uint32_t words[4];
+	counter.GenerateComponents(stream, index, words);
+	qVector4_T<T, ALIGN> result;
+	result.x = min.x + T(float(max.x - min.x) * qRandomCounter::ToFloat(words[0]));
+	result.y = min.y + T(float(max.y - min.y) * qRandomCounter::ToFloat(words[1]));
+	result.z = min.z + T(float(max.z - min.z) * qRandomCounter::ToFloat(words[2]));
+	result.w = min.w + T(float(max.w - min.w) * qRandomCounter::ToFloat(words[3]));
+	return result;
+}
+
+template<class T>
+qRGBA<T> qRandom(const qRandomCounter &counter, const uint64_t stream, const uint64_t index, const qRGBA<T> min, const qRGBA<T> max)
+{
+	uint32_t words[4];
+	counter.GenerateComponents(stream, index, words);
+	qRGBA<T> result;
+	result.r = min.r + T(float(max.r - min.r) * qRandomCounter::ToFloat(words[0]));
+	result.g = min.g + T(float(max.g - min.g) * qRandomCounter::ToFloat(words[1]));
+	result.b = min.b + T(float(max.b - min.b) * qRandomCounter::ToFloat(words[2]));
+	result.a = min.a + T(float(max.a - min.a) * qRandomCounter::ToFloat(words[3]));
+	return result;
+}
+
+//indices firstIndex to firstIndex + count - 1, sixteen blocks at a time; element i matches the scalar call for firstIndex + i bit for bit.
+//with one component qRandomFill01 follows the scalar packing, with more it writes words 0 to components - 1 of each index's block
+void qRandomFill01(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, float* out, const int count, const int components = 1);
+void qRandomFill(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, float* out, const int count, const float min, const float max);
+void qRandomFill(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, int* out, const int count, const int min, const int max);
+
+template<int N, typename T>
+void qRandomFillComponents(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, T* out, const int count, const T* min, const T* max)
+{
+	const int chunk = 256 / N;
+	float unit[chunk * N];
+	for(int base = 0; base < count; base += chunk)
+	{
+		const int elements = qMin(chunk, count - base);
+		qRandomFill01(counter, stream, firstIndex + base, unit, elements, N);
+		for(int i = 0; i < elements; ++i)
+		{
+			for(int k = 0; k < N; ++k)
+			{
+				out[(base + i) * N + k] = min[k] + T(float(max[k] - min[k]) * unit[i * N + k]);
+			}
+		}
+	}
+}
+
+template<int N>
+void qRandomFillComponents(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, float* out, const int count, const float* min, const float* max)
+{
+	//remapped a chunk at a time while it is still in cache
+	const int chunk = 256;
+	for(int base = 0; base < count; base += chunk)
+	{
+		const int elements = qMin(chunk, count - base);
+		qRandomFill01(counter, stream, firstIndex + base, out + base * N, elements, N);
+		qRandomRemapComponents<N>(out + base * N, elements, min, max);
+	}
+}
+
+template<typename T, int ALIGN>
+void qRandomFill(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, qVector2_T<T, ALIGN>* out, const int count, const qVector2_T<T, ALIGN> min, const qVector2_T<T, ALIGN> max)
+{
+	if(count > 0)
+	{
+		qRandomFillComponents<2>(counter, stream, firstIndex, out[0].v, count, min.v, max.v);
+	}
+}
+
+template<typename T, int ALIGN>
+void qRandomFill(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, qVector3_T<T, ALIGN>* out, const int count, const qVector3_T<T, ALIGN> min, const qVector3_T<T, ALIGN> max)
+{
+	if(count > 0)
+	{
+		qRandomFillComponents<3>(counter, stream, firstIndex, out[0].v, count, min.v, max.v);
+	}
+}
+
+template<typename T, int ALIGN>
+void qRandomFill(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, qVector4_T<T, ALIGN>* out, const int count, const qVector4_T<T, ALIGN> min, const qVector4_T<T, ALIGN> max)
+{
+	if(count > 0)
+	{
+		qRandomFillComponents<4>(counter, stream, firstIndex, out[0].v, count, min.v, max.v);
+	}
+}
+
+template<class T>
+void qRandomFill(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, qRGBA<T>* out, const int count, const qRGBA<T> min, const qRGBA<T> max)
+{
+	if(count > 0)
+	{
+		qRandomFillComponents<4>(counter, stream, firstIndex, out[0].rgba, count, min.rgba, max.rgba);
+	}
+}
+
+#pragma mark parallel
+
+//cuts count items into a fixed number of slices, slice i drawing from jump stream i of the engine. the values depend only on
+//the engine and the slice count, never on which thread runs a slice, so one thread and sixteen fill identically
+class qRandomPartition
+{
+public:
+	
+	static const int DefaultSlices = 64;
+	
+	qRandomPartition(qRandomEngine &engine, const int _count, const int _slices = DefaultSlices)
+	: count(_count)
+	, streams(qMax(_slices, 1))
+	{
+		qASSERT(count >= 0);
+		engine.Split(streams.data(), int(streams.size()));
+	}
+	
+	int Slices() const
+	{
+		return int(streams.size());
+	}
+	
+	int Begin(const int slice) const
+	{
+		return int(int64_t(count) * slice / Slices());
+	}
+	
+	int End(const int slice) const
+	{
+		return Begin(slice + 1);
+	}
+	
+	qRandomEngine& Engine(const int slice)
+	{
+		return streams[slice];
+	}
+	
+private:
+	
+	int count;
+	std::vector<qRandomEngine> streams;
+};
+
+//task(engine, begin, end) for every slice of a partition of count items, spread over a thread pool
+template<class TASK>
+void qRandomParallel(qRandomEngine &engine, const int count, TASK task, const int threads = 0, const int slices = qRandomPartition::DefaultSlices)
+{
+	qRandomPartition partition(engine, count, slices);
+	qRunParallel(partition.Slices(), [&](const int slice)
+	{
+		task(partition.Engine(slice), partition.Begin(slice), partition.End(slice));
+	}, threads);
+}
+
+//any qRandomFill, split across threads; equal to the same call with threads = 1
+template<class T>
+void qRandomParallelFill(qRandomEngine &engine, T* out, const int count, const T min, const T max, const int threads = 0, const int slices = qRandomPartition::DefaultSlices)
+{
+	qRandomParallel(engine, count, [&](qRandomEngine &stream, const int begin, const int end)
+	{
+		qRandomFill(stream, out + begin, end - begin, min, max);
+	}, threads, slices);
+}
+
+#pragma mark thread engine
+
+//everything below draws from qRandomEngine::Default(), the calling thread's engine
+
+inline NSUInteger qRandom(const NSUInteger max)
+{
+	return qRandom(qRandomEngine::Default(), max);
+}
+
+inline NSUInteger qRandom(const NSUInteger min, const NSUInteger max)
+{
+	return qRandom(qRandomEngine::Default(), min, max);
+}
+
+template<class T>
+T qRandom(const T max)
+{
+	return qRandom<T>(qRandomEngine::Default(), max);
+}
+
+template<class T>
+T qRandom(const T min, const T max)
+{
+	return qRandom<T>(qRandomEngine::Default(), min, max);
+}
+
+template<typename T, int ALIGN>
+qVector2_T<T, ALIGN> qRandom(const qVector2_T<T, ALIGN> min, const qVector2_T<T, ALIGN> max)
+{
+	return qRandom(qRandomEngine::Default(), min, max);
+}
+
+template<typename T, int ALIGN>
+qVector3_T<T, ALIGN> qRandom(const qVector3_T<T, ALIGN> min, const qVector3_T<T, ALIGN> max)
+{
+	return qRandom(qRandomEngine::Default(), min, max);
+}
+
+template<typename T, int ALIGN>
+qVector4_T<T, ALIGN> qRandom(const qVector4_T<T, ALIGN> min, const qVector4_T<T, ALIGN> max)
+{
+	return qRandom(qRandomEngine::Default(), min, max);
+}
+
+template<class T>
+qRGBA<T> qRandom(const qRGBA<T> min, const qRGBA<T> max)
+{
+	return qRandom(qRandomEngine::Default(), min, max);
+}
+
+inline float qRandomGaussian()
+{
+	return qRandomGaussian(qRandomEngine::Default());
+}
+
+inline float qRandomGaussian(const float mean, const float stdDev)
+{
+	return qRandomGaussian(qRandomEngine::Default(), mean, stdDev);
+}
+
+inline float qRandomTruncatedGaussian(const float mean, const float stdDev, const float min, const float max)
+{
+	return qRandomTruncatedGaussian(qRandomEngine::Default(), mean, stdDev, min, max);
+}
+
+inline int qRandomInt(const int count)
+{
+	return qRandomInt(qRandomEngine::Default(), count);
+}
+
+inline bool qRandomBool()
+{
+	return qRandomBool(qRandomEngine::Default());
+}
 
 template <class TYPE>
 TYPE qPick(const TYPE* list, const int listLength)
 {
-    return list[qRandomInt(listLength)];
+    return qPick(qRandomEngine::Default(), list, listLength);
 }
 
-#endif //__Q_RANDOM_H__
+inline void qRandomFill(float* out, const int count, const float min, const float max)
+{
+	qRandomFill(qRandomEngine::Default(), out, count, min, max);
+}
 
+inline void qRandomFill(int* out, const int count, const int min, const int max)
+{
+	qRandomFill(qRandomEngine::Default(), out, count, min, max);
+}
+
+inline void qRandomFillGaussian(float* out, const int count, const float mean, const float stdDev)
+{
+	qRandomFillGaussian(qRandomEngine::Default(), out, count, mean, stdDev);
+}
+
+template<typename T, int ALIGN>
+void qRandomFill(qVector2_T<T, ALIGN>* out, const int count, const qVector2_T<T, ALIGN> min, const qVector2_T<T, ALIGN> max)
+{
+	qRandomFill(qRandomEngine::Default(), out, count, min, max);
+}
+
+template<typename T, int ALIGN>
+void qRandomFill(qVector3_T<T, ALIGN>* out, const int count, const qVector3_T<T, ALIGN> min, const qVector3_T<T, ALIGN> max)
+{
+	qRandomFill(qRandomEngine::Default(), out, count, min, max);
+}
+
+template<typename T, int ALIGN>
+void qRandomFill(qVector4_T<T, ALIGN>* out, const int count, const qVector4_T<T, ALIGN> min, const qVector4_T<T, ALIGN> max)
+{
+	qRandomFill(qRandomEngine::Default(), out, count, min, max);
+}
+
+template<class T>
+void qRandomFill(qRGBA<T>* out, const int count, const qRGBA<T> min, const qRGBA<T> max)
+{
+	qRandomFill(qRandomEngine::Default(), out, count, min, max);
+}
+
+#endif //__Q_RANDOM_H__
@@ -0,0 +1,122 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_RANDOM_COUNTER_H__
+#define __Q_RANDOM_COUNTER_H__
+
+#include <stdint.h>
+#include "qCore.h"
+
+/*
+ Philox4x32-10, a counter based generator: the output for (seed, stream, index) is a pure function of those three,
+ so particle i or pixel (x, y) gets the same values on any thread, in any order, with nothing shared between workers.
+ each block is four 32 bit words. scalar draws pack sixty four indices into sixteen consecutive blocks the way the batch
+ kernels lay them out: index i is word (i / 16) % 4 of block (i / 64) * 16 + i % 16. the vector and colour overloads give
+ each index a whole block, word k for component k, and qWeightedPicker takes words 0 and 1 of one.
+*/
+
+class qRandomCounter
+{
+public:
+	
+	uint32_t key[2];
+	
+	explicit qRandomCounter(const uint64_t seed = 0x9E3779B97F4A7C15ull)
+	{
+		key[0] = uint32_t(seed);
+		key[1] = uint32_t(seed >> 32);
+	}
+	
+	static const int Rounds = 10;
+	static const uint32_t M0 = 0xD2511F53u;
+	static const uint32_t M1 = 0xCD9E8D57u;
+	static const uint32_t W0 = 0x9E3779B9u;
+	static const uint32_t W1 = 0xBB67AE85u;
+	
+#pragma mark generation
+	
+	void Generate(const uint64_t stream, const uint64_t block, uint32_t out[4]) const
+	{
+		uint32_t c0 = uint32_t(block);
+		uint32_t c1 = uint32_t(block >> 32);
+		uint32_t c2 = uint32_t(stream);
+		uint32_t c3 = uint32_t(stream >> 32);
+		uint32_t k0 = key[0];
+		uint32_t k1 = key[1];
+		
+		for(int r = 0; r < Rounds; ++r)
+		{
+			const uint64_t p0 = uint64_t(M0) * c0;
+			const uint64_t p1 = uint64_t(M1) * c2;
+			c0 = uint32_t(p1 >> 32) ^ c1 ^ k0;
+			c2 = uint32_t(p0 >> 32) ^ c3 ^ k1;
+			c1 = uint32_t(p1);
+			c3 = uint32_t(p0);
+			k0 += W0;
+			k1 += W1;
+		}
+		
+		out[0] = c0;
+		out[1] = c1;
+		out[2] = c2;
+		out[3] = c3;
+	}
+	
+	//the layouts would otherwise share blocks, so a particle's scalar, vector and pick at one (stream, index) would be
+	//the same words. scalar blocks stay below 2^62; the component layout sets bit 63 of the block number and picks set
+	//bit 62, which keeps the three apart for any index below 2^62. vectors and colours share the component layout, so
+	//two attributes drawn through it, like two floats, still need their own streams
+	static const uint64_t ComponentBlocks = 1ull << 63;
+	static const uint64_t PickBlocks = 1ull << 62;
+	
+	void GenerateComponents(const uint64_t stream, const uint64_t index, uint32_t out[4]) const
+	{
+		qASSERT(index < PickBlocks);
+		Generate(stream, ComponentBlocks | index, out);
+	}
+	
+	void GeneratePick(const uint64_t stream, const uint64_t index, uint32_t out[4]) const
+	{
+		qASSERT(index < PickBlocks);
+		Generate(stream, PickBlocks | index, out);
+	}
+	
+	uint32_t Next32(const uint64_t stream, const uint64_t index) const
+	{
+		uint32_t words[4];
+		Generate(stream, ((index >> 6) << 4) | (index & 15), words);
+		return words[(index >> 4) & 3];
+	}
+	
+	float NextFloat(const uint64_t stream, const uint64_t index) const
+	{
+		return ToFloat(Next32(stream, index));
+	}
+	
+	//[0, 1) from the top 24 bits, the same mapping as qRandomEngine::NextFloat
+	static float ToFloat(const uint32_t word)
+	{
+		return float(word >> 8) * (1.0f / 16777216.0f);
+	}
+};
+
+#endif // __Q_RANDOM_COUNTER_H__
@@ -0,0 +1,187 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_RANDOM_ENGINE_H__
+#define __Q_RANDOM_ENGINE_H__
+
+#include <stdint.h>
+#include "qCore.h"
+
+/*
+ xoshiro256** with explicit state; 256 bits, period 2^256 - 1, no locks.
+ every thread gets its own Default() instance, seeded from the qSeedRandom seed and the order threads first ask for one,
+ so a fixed seed and a fixed spawn order reproduce the same streams.
+ Jump and LongJump advance 2^128 and 2^192 draws, which cuts the period into 2^128 disjoint streams for worker threads.
+*/
+
+class qRandomEngine
+{
+public:
+	
+	uint64_t s[4];
+	
+	explicit qRandomEngine(const uint64_t seed = 0x9E3779B97F4A7C15ull)
+	{
+		Seed(seed);
+	}
+	
+	//expands one 64 bit seed with splitmix64, which never leaves the state all zero
+	void Seed(uint64_t seed)
+	{
+		for(int i = 0; i < 4; ++i)
+		{
+			seed += 0x9E3779B97F4A7C15ull;
+			uint64_t z = seed;
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			s[i] = z ^ (z >> 31);
+		}
+	}
+	
+#pragma mark generation
+	
+	uint64_t Next()
+	{
+		const uint64_t result = Rotl(s[1] * 5, 7) * 9;
+		const uint64_t t = s[1] << 17;
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = Rotl(s[3], 45);
+		return result;
+	}
+	
+	uint32_t Next32()
+	{
+		return uint32_t(Next() >> 32);
+	}
+	
+	//[0, 1) from the top 24 bits, every value exactly representable
+	float NextFloat()
+	{
+		return float(Next() >> 40) * (1.0f / 16777216.0f);
+	}
+	
+	//[0, 1) from the top 53 bits
+	double NextDouble()
+	{
+		return double(Next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+	
+	//[0, count) without modulo bias, Lemire's multiply and reject
+	uint32_t NextBounded(const uint32_t count)
+	{
+		qASSERT(count > 0);
+		uint64_t product = uint64_t(Next32()) * count;
+		uint32_t low = uint32_t(product);
+		if(low < count)
+		{
+			const uint32_t threshold = (0u - count) % count;
+			while(low < threshold)
+			{
+				product = uint64_t(Next32()) * count;
+				low = uint32_t(product);
+			}
+		}
+		return uint32_t(product >> 32);
+	}
+	
+#pragma mark streams
+	
+	//advances 2^128 draws
+	void Jump()
+	{
+		static const uint64_t poly[4] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+		Advance(poly);
+	}
+	
+	//advances 2^192 draws, past 2^64 Jump streams
+	void LongJump()
+	{
+		static const uint64_t poly[4] = { 0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull };
+		Advance(poly);
+	}
+	
+	//streams[i] is this engine jumped i times, so each owns 2^128 draws no other stream reaches. this engine then long jumps
+	//past all of them, so it can keep drawing or split again without overlapping the streams it handed out
+	void Split(qRandomEngine* streams, const int count)
+	{
+		qASSERT(count >= 0);
+		qRandomEngine stream = *this;
+		for(int i = 0; i < count; ++i)
+		{
+			streams[i] = stream;
+			stream.Jump();
+		}
+		LongJump();
+	}
+	
+#pragma mark defaults
+	
+	//the calling thread's engine
+	static qRandomEngine& Default()
+	{
+		static thread_local qRandomEngine engine(ThreadSeed());
+		return engine;
+	}
+	
+	//the qSeedRandom seed mixed with the calling thread's index, so no two threads share a stream
+	static uint64_t ThreadSeed();
+	
+	//an engine seeded from the qSeedRandom seed alone, the same on every thread; split it to hand a pool reproducible streams
+	static qRandomEngine Root();
+	
+private:
+	
+	//the state 2^n draws ahead, as the jump polynomial x^(2^n) mod the characteristic polynomial applied to the state
+	void Advance(const uint64_t (&poly)[4])
+	{
+		uint64_t t[4] = { 0, 0, 0, 0 };
+		for(int i = 0; i < 4; ++i)
+		{
+			for(int b = 0; b < 64; ++b)
+			{
+				if(poly[i] & (1ull << b))
+				{
+					t[0] ^= s[0];
+					t[1] ^= s[1];
+					t[2] ^= s[2];
+					t[3] ^= s[3];
+				}
+				Next();
+			}
+		}
+		s[0] = t[0];
+		s[1] = t[1];
+		s[2] = t[2];
+		s[3] = t[3];
+	}
+	
+	static uint64_t Rotl(const uint64_t x, const int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+};
+
+#endif // __Q_RANDOM_ENGINE_H__
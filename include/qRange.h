@@ -24,6 +24,7 @@ SOFTWARE.
 #define __Q_RANGE_H__
 
 #include "qRandom.h"
+#include "qInverseCDF.h"
 #include <iostream>
 
 template<typename T>
@@ -33,16 +34,23 @@ struct qRange
 	{
 		eSampleMode_Uniform,
 		eSampleMode_Gaussian,
+		eSampleMode_TruncatedGaussian,
+		eSampleMode_Exponential,
+		eSampleMode_Triangular,
+		eSampleMode_LogNormal,
+		eSampleMode_Curve,
 	};
 	
     T min;
     T max;
 	SampleMode sampleMode;
+	const qInverseCDF* curve;
 	
     qRange()
 	: min(T(0))
 	, max(T(0))
 	, sampleMode(eSampleMode_Uniform)
+	, curve(nullptr)
     {
     }
 	
@@ -50,6 +58,7 @@ struct qRange
 	: min(_val)
 	, max(_val)
 	, sampleMode(_sampleMode)
+	, curve(nullptr)
 	{
 	}
     
@@ -57,28 +66,108 @@ struct qRange
     : min(_min)
     , max(_max)
 	, sampleMode(_sampleMode)
+	, curve(nullptr)
     {
     }
+	
+	//eSampleMode_Curve; the table has to outlive the range, so share one from qInverseCDF::Intern or keep it alongside
+	qRange(const T _min, const T _max, const qInverseCDF* _curve)
+	: min(_min)
+	, max(_max)
+	, sampleMode(eSampleMode_Curve)
+	, curve(_curve)
+	{
+		qASSERT(curve != nullptr);
+	}
+	
+	//the table behind the table driven modes, null for the others
+	const qInverseCDF* Shape() const
+	{
+		switch(sampleMode)
+		{
+			case eSampleMode_Exponential:
+				return &qInverseCDF::Exponential();
+			case eSampleMode_Triangular:
+				return &qInverseCDF::Triangular();
+			case eSampleMode_LogNormal:
+				return &qInverseCDF::LogNormal();
+			case eSampleMode_Curve:
+				return curve;
+			default:
+				return nullptr;
+		}
+	}
 
     T RandomInRange() const
+    {
+		return RandomInRange(qRandomEngine::Default());
+    }
+	
+    T RandomInRange(qRandomEngine &engine) const
     {
 		switch(sampleMode)
 		{
 			case eSampleMode_Uniform:
-				return qRandom(min, max);
+				return qRandom(engine, min, max);
 			case eSampleMode_Gaussian:
-				while(true)
+			{
+				//centred, with a standard deviation of 0.15 of the range; the under 0.1% of draws that fall outside are redrawn
+				float unit;
+				do
 				{
-					T candidate = qRandom(T(0), T(1));
-					T gaussian = exp(-(candidate-T(0.5))*(candidate-T(0.5))/0.045);
-					if (qRandom(T(0), T(1)) < gaussian)
-					{
-						return candidate * (max - min) + min;
-					}
+					unit = qRandomGaussian(engine, 0.5f, 0.15f);
 				}
+				while(unit < 0.0f || unit >= 1.0f);
+				return min + T(float(max - min) * unit);
+			}
+			case eSampleMode_TruncatedGaussian:
+			{
+				//the same shape in one draw with no retries, for callers that need a fixed cost per sample
+				static const qTruncatedGaussian shape(0.5f, 0.15f, 0.0f, 1.0f);
+				const float unit = shape.Sample(engine);
+				return min + T(float(max - min) * unit);
+			}
+			case eSampleMode_Exponential:
+			case eSampleMode_Triangular:
+			case eSampleMode_LogNormal:
+			case eSampleMode_Curve:
+				return min + T(float(max - min) * Shape()->Sample(engine));
 		}
+		return min;
     }
 	
+	//count values at once; uniform and the table driven modes fill in bulk, the gaussian modes draw one at a time
+	void RandomInRange(qRandomEngine &engine, T* out, const int count) const
+	{
+		const qInverseCDF* shape = Shape();
+		if(sampleMode == eSampleMode_Uniform)
+		{
+			qRandomFill(engine, out, count, min, max);
+		}
+		else if(shape != nullptr)
+		{
+			const int chunk = 256;
+			float unit[chunk];
+			const float range = float(max - min);
+			for(int base = 0; base < count; base += chunk)
+			{
+				const int elements = qMin(chunk, count - base);
+				shape->Fill(engine, unit, elements);
+				for(int i = 0; i < elements; ++i)
+				{
+					out[base + i] = min + T(range * unit[i]);
+				}
+			}
+		}
+		else
+		{
+			for(int i = 0; i < count; ++i)
+			{
+				out[i] = RandomInRange(engine);
+			}
+		}
+	}
+	
 	T Median() const
 	{
 		return (min + max) / T(2);
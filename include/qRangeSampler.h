@@ -0,0 +1,137 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_RANGE_SAMPLER_H__
+#define __Q_RANGE_SAMPLER_H__
+
+#include <vector>
+#include "qRange.h"
+
+/*
+ a set of qRanges compiled into per sample mode tables, so an emitter fills whole attribute columns for many spawns at once
+ instead of calling RandomInRange, and switching on the mode, once per field per spawn. float field i lands in floatColumns[i]
+ and int field i in intColumns[i], in the order they were added. the values follow the same distributions as RandomInRange,
+ though not the same sequence, since every column draws its count values together. recompile after editing the ranges.
+*/
+
+class qRangeSampler
+{
+public:
+	
+	qRangeSampler()
+	: floatCount(0)
+	, intCount(0)
+	{
+	}
+	
+	qRangeSampler(const qRangeF* floats, const int _floatCount, const qRangeI* ints, const int _intCount)
+	: qRangeSampler()
+	{
+		for(int i = 0; i < _floatCount; ++i)
+		{
+			Add(floats[i]);
+		}
+		for(int i = 0; i < _intCount; ++i)
+		{
+			Add(ints[i]);
+		}
+	}
+	
+	//returns the field's column
+	int Add(const qRangeF &range);
+	int Add(const qRangeI &range);
+	
+	int FloatCount() const
+	{
+		return floatCount;
+	}
+	
+	int IntCount() const
+	{
+		return intCount;
+	}
+	
+	void Sample(qRandomEngine &engine, const int count, float* const* floatColumns, int* const* intColumns) const;
+	
+	void Sample(const int count, float* const* floatColumns, int* const* intColumns) const
+	{
+		Sample(qRandomEngine::Default(), count, floatColumns, intColumns);
+	}
+	
+private:
+	
+	//the inverse cdf modes share one table, each field keeping its shape; fields with min == max draw nothing and
+	//get a fill, so they have a table of their own
+	enum Table
+	{
+		eTable_Uniform,
+		eTable_Gaussian,
+		eTable_TruncatedGaussian,
+		eTable_Shaped,
+		eTable_Constant,
+		eTable_Count,
+	};
+	
+	template<typename T>
+	struct Fields
+	{
+		std::vector<int> column;
+		std::vector<T> min;
+		std::vector<T> max;
+		std::vector<const qInverseCDF*> shape;
+		
+		int Count() const
+		{
+			return int(column.size());
+		}
+		
+		void Add(const int _column, const qRange<T> &range)
+		{
+			column.push_back(_column);
+			min.push_back(range.min);
+			max.push_back(range.max);
+			shape.push_back(range.Shape());
+		}
+	};
+	
+	template<typename T>
+	static Table TableFor(const qRange<T> &range)
+	{
+		if(range.min == range.max)
+		{
+			return eTable_Constant;
+		}
+		if(range.Shape() != nullptr)
+		{
+			return eTable_Shaped;
+		}
+		return range.sampleMode == qRange<T>::eSampleMode_Gaussian ? eTable_Gaussian
+			: range.sampleMode == qRange<T>::eSampleMode_TruncatedGaussian ? eTable_TruncatedGaussian : eTable_Uniform;
+	}
+	
+	Fields<float> floats[eTable_Count];
+	Fields<int> ints[eTable_Count];
+	int floatCount;
+	int intCount;
+};
+
+#endif //__Q_RANGE_SAMPLER_H__
@@ -0,0 +1,448 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_SIMD_H__
+#define __Q_SIMD_H__
+
+//thin wrapper over the 4-wide float registers of the target; define qMATH_NO_SIMD to force the scalar paths
+
+#if defined(qMATH_NO_SIMD)
+	#define qSIMD_ENABLED 0
+#elif defined(__SSE2__) || defined(_M_X64)
+	#define qSIMD_ENABLED 1
+	#define qSIMD_SSE 1
+	#include <emmintrin.h>
+	#if defined(__AVX__)
+		#define qSIMD_AVX 1
+		#include <immintrin.h>
+	#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define qSIMD_ENABLED 1
+	#define qSIMD_NEON 1
+	#include <arm_neon.h>
+#else
+	#define qSIMD_ENABLED 0
+#endif
+
+//number of floats processed per step by the kernels below
+#if qSIMD_ENABLED
+	#define qSIMD_WIDTH 4
+#else
+	#define qSIMD_WIDTH 1
+#endif
+
+#if qSIMD_ENABLED
+
+namespace qSIMD
+{
+#if qSIMD_SSE
+	typedef __m128 float4;
+	
+	inline float4 Load(const float* p)					{ return _mm_loadu_ps(p); }
+	inline void Store(float* p, float4 a)				{ _mm_storeu_ps(p, a); }
+	inline float4 Splat(float f)						{ return _mm_set1_ps(f); }
+	inline float4 Add(float4 a, float4 b)				{ return _mm_add_ps(a, b); }
+	inline float4 Sub(float4 a, float4 b)				{ return _mm_sub_ps(a, b); }
+	inline float4 Mul(float4 a, float4 b)				{ return _mm_mul_ps(a, b); }
+	inline float4 Div(float4 a, float4 b)				{ return _mm_div_ps(a, b); }
+	inline float4 Min(float4 a, float4 b)				{ return _mm_min_ps(a, b); }
+	inline float4 Max(float4 a, float4 b)				{ return _mm_max_ps(a, b); }
+	inline float4 Abs(float4 a)							{ return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+	inline float4 Sqrt(float4 a)						{ return _mm_sqrt_ps(a); }
+	
+	//comparison results are all bits set per passing lane
+	typedef __m128 mask4;
+	
+	inline mask4 CmpLt(float4 a, float4 b)				{ return _mm_cmplt_ps(a, b); }
+	inline mask4 CmpLe(float4 a, float4 b)				{ return _mm_cmple_ps(a, b); }
+	inline mask4 CmpGt(float4 a, float4 b)				{ return _mm_cmpgt_ps(a, b); }
+	inline mask4 CmpGe(float4 a, float4 b)				{ return _mm_cmpge_ps(a, b); }
+	inline mask4 CmpEq(float4 a, float4 b)				{ return _mm_cmpeq_ps(a, b); }
+	inline mask4 CmpNeq(float4 a, float4 b)				{ return _mm_cmpneq_ps(a, b); }
+	inline mask4 And(mask4 a, mask4 b)					{ return _mm_and_ps(a, b); }
+	inline mask4 Or(mask4 a, mask4 b)					{ return _mm_or_ps(a, b); }
+	inline mask4 Xor(mask4 a, mask4 b)					{ return _mm_xor_ps(a, b); }
+	inline mask4 Not(mask4 a)							{ return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+	inline int MaskBits(mask4 a)						{ return _mm_movemask_ps(a); }
+	
+	//lanes of a where mask is set, otherwise lanes of b
+	inline float4 Select(mask4 mask, float4 a, float4 b)	{ return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+	
+	inline float HorizontalAdd(float4 a)
+	{
+		float4 t = _mm_add_ps(a, _mm_movehl_ps(a, a));
+		return _mm_cvtss_f32(_mm_add_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+	}
+	
+	inline float HorizontalMin(float4 a)
+	{
+		float4 t = _mm_min_ps(a, _mm_movehl_ps(a, a));
+		return _mm_cvtss_f32(_mm_min_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+	}
+	
+	inline float HorizontalMax(float4 a)
+	{
+		float4 t = _mm_max_ps(a, _mm_movehl_ps(a, a));
+		return _mm_cvtss_f32(_mm_max_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+	}
+	
+	//a * b + c
+	inline float4 MulAdd(float4 a, float4 b, float4 c)
+	{
+	#if defined(__FMA__)
+		return _mm_fmadd_ps(a, b, c);
+	#else
+		return _mm_add_ps(_mm_mul_ps(a, b), c);
+	#endif
+	}
+	
+	template<int LANE>
+	inline float4 Broadcast(float4 a)					{ return _mm_shuffle_ps(a, a, _MM_SHUFFLE(LANE, LANE, LANE, LANE)); }
+	
+	//4 packed 3 component vectors (12 floats) to and from x, y, z registers
+	inline void Load3x4(const float* p, float4 &x, float4 &y, float4 &z)
+	{
+		float4 a = _mm_loadu_ps(p + 0);
+		float4 b = _mm_loadu_ps(p + 4);
+		float4 c = _mm_loadu_ps(p + 8);
+		x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+		y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+	}
+	
+	inline void Store3x4(float* p, float4 x, float4 y, float4 z)
+	{
+		float4 a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+		float4 b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+		float4 c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		_mm_storeu_ps(p + 0, a);
+		_mm_storeu_ps(p + 4, b);
+		_mm_storeu_ps(p + 8, c);
+	}
+	
+	//4 packed 4 component vectors to and from x, y, z, w registers
+	inline void Load4x4(const float* p, float4 &x, float4 &y, float4 &z, float4 &w)
+	{
+		x = _mm_loadu_ps(p + 0);
+		y = _mm_loadu_ps(p + 4);
+		z = _mm_loadu_ps(p + 8);
+		w = _mm_loadu_ps(p + 12);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+	}
+	
+	inline void Store4x4(float* p, float4 x, float4 y, float4 z, float4 w)
+	{
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_mm_storeu_ps(p + 0, x);
+		_mm_storeu_ps(p + 4, y);
+		_mm_storeu_ps(p + 8, z);
+		_mm_storeu_ps(p + 12, w);
+	}
+	
+#if qSIMD_AVX
+	typedef __m256 float8;
+	typedef __m256 mask8;
+	
+	inline float8 Load8(const float* p)					{ return _mm256_loadu_ps(p); }
+	inline void Store(float* p, float8 a)				{ _mm256_storeu_ps(p, a); }
+	inline float8 Splat8(float f)						{ return _mm256_set1_ps(f); }
+	inline float8 Add(float8 a, float8 b)				{ return _mm256_add_ps(a, b); }
+	inline float8 Sub(float8 a, float8 b)				{ return _mm256_sub_ps(a, b); }
+	inline float8 Mul(float8 a, float8 b)				{ return _mm256_mul_ps(a, b); }
+	inline float8 Div(float8 a, float8 b)				{ return _mm256_div_ps(a, b); }
+	inline float8 Min(float8 a, float8 b)				{ return _mm256_min_ps(a, b); }
+	inline float8 Max(float8 a, float8 b)				{ return _mm256_max_ps(a, b); }
+	inline float8 Abs(float8 a)							{ return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+	inline float8 Sqrt(float8 a)						{ return _mm256_sqrt_ps(a); }
+	
+	inline float8 MulAdd(float8 a, float8 b, float8 c)
+	{
+	#if defined(__FMA__)
+		return _mm256_fmadd_ps(a, b, c);
+	#else
+		return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+	#endif
+	}
+	
+	inline mask8 CmpLt(float8 a, float8 b)				{ return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	inline mask8 CmpLe(float8 a, float8 b)				{ return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+	inline mask8 CmpGt(float8 a, float8 b)				{ return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	inline mask8 CmpGe(float8 a, float8 b)				{ return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+	inline mask8 CmpEq(float8 a, float8 b)				{ return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+	inline mask8 CmpNeq(float8 a, float8 b)				{ return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+	inline mask8 And(mask8 a, mask8 b)					{ return _mm256_and_ps(a, b); }
+	inline mask8 Or(mask8 a, mask8 b)					{ return _mm256_or_ps(a, b); }
+	inline mask8 Xor(mask8 a, mask8 b)					{ return _mm256_xor_ps(a, b); }
+	inline mask8 Not(mask8 a)							{ return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+	inline int MaskBits(mask8 a)						{ return _mm256_movemask_ps(a); }
+	inline float8 Select(mask8 mask, float8 a, float8 b)	{ return _mm256_blendv_ps(b, a, mask); }
+	
+	inline float HorizontalAdd(float8 a)				{ return HorizontalAdd(_mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1))); }
+	inline float HorizontalMin(float8 a)				{ return HorizontalMin(_mm_min_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1))); }
+	inline float HorizontalMax(float8 a)				{ return HorizontalMax(_mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1))); }
+#endif
+#elif qSIMD_NEON
+	typedef float32x4_t float4;
+	
+	inline float4 Load(const float* p)					{ return vld1q_f32(p); }
+	inline void Store(float* p, float4 a)				{ vst1q_f32(p, a); }
+	inline float4 Splat(float f)						{ return vdupq_n_f32(f); }
+	inline float4 Add(float4 a, float4 b)				{ return vaddq_f32(a, b); }
+	inline float4 Sub(float4 a, float4 b)				{ return vsubq_f32(a, b); }
+	inline float4 Mul(float4 a, float4 b)				{ return vmulq_f32(a, b); }
+	inline float4 Min(float4 a, float4 b)				{ return vminq_f32(a, b); }
+	inline float4 Max(float4 a, float4 b)				{ return vmaxq_f32(a, b); }
+	inline float4 Abs(float4 a)							{ return vabsq_f32(a); }
+	inline float4 MulAdd(float4 a, float4 b, float4 c)	{ return vmlaq_f32(c, a, b); }
+	
+#if defined(__aarch64__)
+	inline float4 Div(float4 a, float4 b)				{ return vdivq_f32(a, b); }
+	inline float4 Sqrt(float4 a)						{ return vsqrtq_f32(a); }
+#else
+	//armv7 has no vector divide or square root; the estimates are refined by two Newton steps each
+	inline float4 Div(float4 a, float4 b)
+	{
+		float4 r = vrecpeq_f32(b);
+		r = vmulq_f32(vrecpsq_f32(b, r), r);
+		r = vmulq_f32(vrecpsq_f32(b, r), r);
+		return vmulq_f32(a, r);
+	}
+	
+	inline float4 Sqrt(float4 a)
+	{
+		float4 r = vrsqrteq_f32(a);
+		r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+		r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+		//the estimate of 1 / sqrt(0) is inf, so zero lanes pass through rather than become 0 * inf
+		return vbslq_f32(vceqq_f32(a, vdupq_n_f32(0.0f)), a, vmulq_f32(a, r));
+	}
+#endif
+	
+	typedef uint32x4_t mask4;
+	
+	inline mask4 CmpLt(float4 a, float4 b)				{ return vcltq_f32(a, b); }
+	inline mask4 CmpLe(float4 a, float4 b)				{ return vcleq_f32(a, b); }
+	inline mask4 CmpGt(float4 a, float4 b)				{ return vcgtq_f32(a, b); }
+	inline mask4 CmpGe(float4 a, float4 b)				{ return vcgeq_f32(a, b); }
+	inline mask4 CmpEq(float4 a, float4 b)				{ return vceqq_f32(a, b); }
+	inline mask4 CmpNeq(float4 a, float4 b)				{ return vmvnq_u32(vceqq_f32(a, b)); }
+	inline mask4 And(mask4 a, mask4 b)					{ return vandq_u32(a, b); }
+	inline mask4 Or(mask4 a, mask4 b)					{ return vorrq_u32(a, b); }
+	inline mask4 Xor(mask4 a, mask4 b)					{ return veorq_u32(a, b); }
+	inline mask4 Not(mask4 a)							{ return vmvnq_u32(a); }
+	
+	inline float4 Select(mask4 mask, float4 a, float4 b)	{ return vbslq_f32(mask, a, b); }
+	
+#if defined(__aarch64__)
+	inline int MaskBits(mask4 a)
+	{
+		const uint32_t bits[4] = { 1, 2, 4, 8 };
+		return (int)vaddvq_u32(vandq_u32(a, vld1q_u32(bits)));
+	}
+	
+	inline float HorizontalAdd(float4 a)				{ return vaddvq_f32(a); }
+	inline float HorizontalMin(float4 a)				{ return vminvq_f32(a); }
+	inline float HorizontalMax(float4 a)				{ return vmaxvq_f32(a); }
+#else
+	//armv7 reduces with pairwise ops on the two halves
+	inline int MaskBits(mask4 a)
+	{
+		const uint32_t bits[4] = { 1, 2, 4, 8 };
+		uint32x4_t m = vandq_u32(a, vld1q_u32(bits));
+		uint32x2_t p = vpadd_u32(vget_low_u32(m), vget_high_u32(m));
+		return (int)vget_lane_u32(vpadd_u32(p, p), 0);
+	}
+	
+	inline float HorizontalAdd(float4 a)
+	{
+		float32x2_t p = vpadd_f32(vget_low_f32(a), vget_high_f32(a));
+		return vget_lane_f32(vpadd_f32(p, p), 0);
+	}
+	
+	inline float HorizontalMin(float4 a)
+	{
+		float32x2_t p = vpmin_f32(vget_low_f32(a), vget_high_f32(a));
+		return vget_lane_f32(vpmin_f32(p, p), 0);
+	}
+	
+	inline float HorizontalMax(float4 a)
+	{
+		float32x2_t p = vpmax_f32(vget_low_f32(a), vget_high_f32(a));
+		return vget_lane_f32(vpmax_f32(p, p), 0);
+	}
+#endif
+	
+	template<int LANE>
+	inline float4 Broadcast(float4 a)					{ return vdupq_n_f32(vgetq_lane_f32(a, LANE)); }
+	
+	inline void Load3x4(const float* p, float4 &x, float4 &y, float4 &z)
+	{
+		float32x4x3_t v = vld3q_f32(p);
+		x = v.val[0];
+		y = v.val[1];
+		z = v.val[2];
+	}
+	
+	inline void Store3x4(float* p, float4 x, float4 y, float4 z)
+	{
+		float32x4x3_t v = { { x, y, z } };
+		vst3q_f32(p, v);
+	}
+	
+	inline void Load4x4(const float* p, float4 &x, float4 &y, float4 &z, float4 &w)
+	{
+		float32x4x4_t v = vld4q_f32(p);
+		x = v.val[0];
+		y = v.val[1];
+		z = v.val[2];
+		w = v.val[3];
+	}
+	
+	inline void Store4x4(float* p, float4 x, float4 y, float4 z, float4 w)
+	{
+		float32x4x4_t v = { { x, y, z, w } };
+		vst4q_f32(p, v);
+	}
+#endif
+
+#pragma mark matrix kernels
+	
+	//column major 4x4; out may alias lhs or rhs
+	inline void Matrix4Multiply(float* out, const float* lhs, const float* rhs)
+	{
+		float4 c0 = Load(lhs + 0);
+		float4 c1 = Load(lhs + 4);
+		float4 c2 = Load(lhs + 8);
+		float4 c3 = Load(lhs + 12);
+		
+		float4 r0 = Load(rhs + 0);
+		float4 r1 = Load(rhs + 4);
+		float4 r2 = Load(rhs + 8);
+		float4 r3 = Load(rhs + 12);
+		
+		float4 o0 = MulAdd(c3, Broadcast<3>(r0), MulAdd(c2, Broadcast<2>(r0), MulAdd(c1, Broadcast<1>(r0), Mul(c0, Broadcast<0>(r0)))));
+		float4 o1 = MulAdd(c3, Broadcast<3>(r1), MulAdd(c2, Broadcast<2>(r1), MulAdd(c1, Broadcast<1>(r1), Mul(c0, Broadcast<0>(r1)))));
+		float4 o2 = MulAdd(c3, Broadcast<3>(r2), MulAdd(c2, Broadcast<2>(r2), MulAdd(c1, Broadcast<1>(r2), Mul(c0, Broadcast<0>(r2)))));
+		float4 o3 = MulAdd(c3, Broadcast<3>(r3), MulAdd(c2, Broadcast<2>(r3), MulAdd(c1, Broadcast<1>(r3), Mul(c0, Broadcast<0>(r3)))));
+		
+		Store(out + 0, o0);
+		Store(out + 4, o1);
+		Store(out + 8, o2);
+		Store(out + 12, o3);
+	}
+	
+	//column major 4x4 times a 4 component column vector; out may alias v
+	inline void Matrix4Transform(float* out, const float* mat, const float* v)
+	{
+		float4 r = Load(v);
+		float4 o = Mul(Load(mat + 0), Broadcast<0>(r));
+		o = MulAdd(Load(mat + 4), Broadcast<1>(r), o);
+		o = MulAdd(Load(mat + 8), Broadcast<2>(r), o);
+		o = MulAdd(Load(mat + 12), Broadcast<3>(r), o);
+		Store(out, o);
+	}
+	
+#pragma mark batch kernels
+	
+	//count packed 3 component vectors, promoted with the given w; the xyz of the result is written back packed; out may alias in
+	inline void Matrix4TransformArray3(float* out, const float* mat, const float* in, int count, float w)
+	{
+		float4 m00 = Splat(mat[0]), m01 = Splat(mat[1]), m02 = Splat(mat[2]);
+		float4 m10 = Splat(mat[4]), m11 = Splat(mat[5]), m12 = Splat(mat[6]);
+		float4 m20 = Splat(mat[8]), m21 = Splat(mat[9]), m22 = Splat(mat[10]);
+		float4 t0 = Splat(mat[12] * w), t1 = Splat(mat[13] * w), t2 = Splat(mat[14] * w);
+		
+		int i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			float4 x, y, z;
+			Load3x4(in + i * 3, x, y, z);
+			float4 ox = MulAdd(m20, z, MulAdd(m10, y, MulAdd(m00, x, t0)));
+			float4 oy = MulAdd(m21, z, MulAdd(m11, y, MulAdd(m01, x, t1)));
+			float4 oz = MulAdd(m22, z, MulAdd(m12, y, MulAdd(m02, x, t2)));
+			Store3x4(out + i * 3, ox, oy, oz);
+		}
+		
+		for(; i < count; ++i)
+		{
+			const float* v = in + i * 3;
+			float x = v[0], y = v[1], z = v[2];
+			float* o = out + i * 3;
+			o[0] = (mat[0] * x) + (mat[4] * y) + (mat[8] * z) + (mat[12] * w);
+			o[1] = (mat[1] * x) + (mat[5] * y) + (mat[9] * z) + (mat[13] * w);
+			o[2] = (mat[2] * x) + (mat[6] * y) + (mat[10] * z) + (mat[14] * w);
+		}
+	}
+	
+	//count packed 3 component points, promoted with w = 1, to count 4 component vectors
+	inline void Matrix4TransformArray3To4(float* out, const float* mat, const float* in, int count)
+	{
+		float4 m00 = Splat(mat[0]), m01 = Splat(mat[1]), m02 = Splat(mat[2]), m03 = Splat(mat[3]);
+		float4 m10 = Splat(mat[4]), m11 = Splat(mat[5]), m12 = Splat(mat[6]), m13 = Splat(mat[7]);
+		float4 m20 = Splat(mat[8]), m21 = Splat(mat[9]), m22 = Splat(mat[10]), m23 = Splat(mat[11]);
+		float4 m30 = Splat(mat[12]), m31 = Splat(mat[13]), m32 = Splat(mat[14]), m33 = Splat(mat[15]);
+		
+		int i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			float4 x, y, z;
+			Load3x4(in + i * 3, x, y, z);
+			float4 ox = MulAdd(m20, z, MulAdd(m10, y, MulAdd(m00, x, m30)));
+			float4 oy = MulAdd(m21, z, MulAdd(m11, y, MulAdd(m01, x, m31)));
+			float4 oz = MulAdd(m22, z, MulAdd(m12, y, MulAdd(m02, x, m32)));
+			float4 ow = MulAdd(m23, z, MulAdd(m13, y, MulAdd(m03, x, m33)));
+			Store4x4(out + i * 4, ox, oy, oz, ow);
+		}
+		
+		float4 c0 = Load(mat + 0);
+		float4 c1 = Load(mat + 4);
+		float4 c2 = Load(mat + 8);
+		float4 c3 = Load(mat + 12);
+		for(; i < count; ++i)
+		{
+			const float* v = in + i * 3;
+			Store(out + i * 4, MulAdd(c2, Splat(v[2]), MulAdd(c1, Splat(v[1]), MulAdd(c0, Splat(v[0]), c3))));
+		}
+	}
+	
+	//count 4 component vectors; out may alias in
+	inline void Matrix4TransformArray4(float* out, const float* mat, const float* in, int count)
+	{
+		float4 c0 = Load(mat + 0);
+		float4 c1 = Load(mat + 4);
+		float4 c2 = Load(mat + 8);
+		float4 c3 = Load(mat + 12);
+		for(int i = 0; i < count; ++i)
+		{
+			float4 r = Load(in + i * 4);
+			float4 o = Mul(c0, Broadcast<0>(r));
+			o = MulAdd(c1, Broadcast<1>(r), o);
+			o = MulAdd(c2, Broadcast<2>(r), o);
+			o = MulAdd(c3, Broadcast<3>(r), o);
+			Store(out + i * 4, o);
+		}
+	}
+}
+
+#endif // qSIMD_ENABLED
+
+#endif // __Q_SIMD_H__
@@ -0,0 +1,243 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_SAMPLING_H__
+#define __Q_SAMPLING_H__
+
+#include <math.h>
+#include "qCore.h"
+#include "qUtil.h"
+#include "qVector2.h"
+#include "qVector3.h"
+#include "qTriangle.h"
+#include "qQuad.h"
+#include "qPacket.h"
+#include "qVector3x.h"
+#include "qRandomEngine.h"
+
+/*
+ uniform points on shapes by direct mapping from the unit square, so no sample is ever thrown away. every mapping is
+ written once against qSampleMath, which is a plain float or a qFloatx_T packet, and has no branches: the same code is
+ the scalar form and, W lanes at a time, the span fills. the qSquareTo mappings take their uniforms as an argument, so a
+ Sobol or R2 point can be fed in place of white noise.
+*/
+
+#pragma mark lane math
+
+template<typename F>
+struct qSampleMath
+{
+	typedef bool Mask;
+	
+	static F Sqrt(const F a)								{ return sqrt(a); }
+	static F Abs(const F a)									{ return qAbs(a); }
+	static F Max(const F a, const F b)						{ return qMax(a, b); }
+	static F Select(const bool m, const F a, const F b)		{ return m ? a : b; }
+};
+
+template<int W>
+struct qSampleMath<qFloatx_T<W> >
+{
+	typedef qFloatx_T<W> F;
+	typedef qMaskx_T<W> Mask;
+	
+	static F Sqrt(const F &a)								{ return F::Sqrt(a); }
+	static F Abs(const F &a)								{ return F::Abs(a); }
+	static F Max(const F &a, const F &b)					{ return F::Max(a, b); }
+	static F Select(const Mask &m, const F &a, const F &b)	{ return F::Select(m, a, b); }
+};
+
+#pragma mark kernels
+
+template<typename F>
+struct qSampleKernel
+{
+	typedef qSampleMath<F> M;
+	
+	//sin and cos of pi * t for t in [-1, 1]: fold the angle into [-pi/2, pi/2], where degree 11 and 12 Taylor
+	//polynomials are good to a few parts in 1e8
+	static void SinCosPi(const F &t, F &s, F &c)
+	{
+		const F b = F(float(M_PI_2)) - M::Abs(t) * F(float(M_PI));
+		const F b2 = b * b;
+		const F sb = b * (F(1.0f) + b2 * (F(-1.0f / 6.0f) + b2 * (F(1.0f / 120.0f) + b2 * (F(-1.0f / 5040.0f) + b2 * (F(1.0f / 362880.0f) + b2 * F(-1.0f / 39916800.0f))))));
+		const F cb = F(1.0f) + b2 * (F(-0.5f) + b2 * (F(1.0f / 24.0f) + b2 * (F(-1.0f / 720.0f) + b2 * (F(1.0f / 40320.0f) + b2 * (F(-1.0f / 3628800.0f) + b2 * F(1.0f / 479001600.0f))))));
+		c = sb;
+		s = M::Select(t < F(0.0f), F(0.0f) - cb, cb);
+	}
+	
+	//Duff et al.'s branchless basis; the sign select is a blend, not a jump
+	static void Basis(const F &nx, const F &ny, const F &nz, F &tx, F &ty, F &tz, F &bx, F &by, F &bz)
+	{
+		const F sign = M::Select(nz >= F(0.0f), F(1.0f), F(-1.0f));
+		const F a = F(-1.0f) / (sign + nz);
+		const F b = nx * ny * a;
+		tx = F(1.0f) + sign * nx * nx * a;
+		ty = sign * b;
+		tz = F(0.0f) - sign * nx;
+		bx = b;
+		by = sign + ny * ny * a;
+		bz = F(0.0f) - ny;
+	}
+	
+	static void Sphere(const F &u1, const F &u2, F &x, F &y, F &z)
+	{
+		z = F(1.0f) - F(2.0f) * u1;
+		const F r = M::Sqrt(M::Max(F(0.0f), F(1.0f) - z * z));
+		F s, c;
+		SinCosPi(F(2.0f) * u2 - F(1.0f), s, c);
+		x = r * c;
+		y = r * s;
+	}
+	
+	//the largest of three uniforms has density 3r^2, exactly the radius of a uniform ball, with no cube root
+	static void Ball(const F &u1, const F &u2, const F &u3, const F &u4, const F &u5, F &x, F &y, F &z)
+	{
+		Sphere(u1, u2, x, y, z);
+		const F r = M::Max(u3, M::Max(u4, u5));
+		x = x * r;
+		y = y * r;
+		z = z * r;
+	}
+	
+	//Shirley and Chiu's concentric map: the larger of |a| and |b| is the radius, their ratio the angle within the octant
+	static void Disk(const F &u1, const F &u2, F &x, F &y)
+	{
+		const F a = F(2.0f) * u1 - F(1.0f);
+		const F b = F(2.0f) * u2 - F(1.0f);
+		const typename M::Mask wide = M::Abs(a) > M::Abs(b);
+		const F large = M::Select(wide, a, b);
+		const F small = M::Select(wide, b, a);
+		const F ratio = small / M::Select(large == F(0.0f), F(1.0f), large);
+		F s, c;
+		SinCosPi(ratio * F(0.25f), s, c);
+		x = large * M::Select(wide, c, s);
+		y = large * M::Select(wide, s, c);
+	}
+	
+	//Malley: lift the concentric disk onto the hemisphere around +z
+	static void CosineHemisphere(const F &u1, const F &u2, F &x, F &y, F &z)
+	{
+		Disk(u1, u2, x, y);
+		z = M::Sqrt(M::Max(F(0.0f), F(1.0f) - x * x - y * y));
+	}
+	
+	//uniform over the cap around +z whose half angle has cosine cosMax
+	static void Cone(const F &u1, const F &u2, const F &cosMax, F &x, F &y, F &z)
+	{
+		z = F(1.0f) - u1 * (F(1.0f) - cosMax);
+		const F r = M::Sqrt(M::Max(F(0.0f), F(1.0f) - z * z));
+		F s, c;
+		SinCosPi(F(2.0f) * u2 - F(1.0f), s, c);
+		x = r * c;
+		y = r * s;
+	}
+	
+	//barycentric weights of a uniform point, by the square root warp
+	static void Triangle(const F &u1, const F &u2, F &wa, F &wb, F &wc)
+	{
+		const F s = M::Sqrt(u1);
+		wa = F(1.0f) - s;
+		wb = s * (F(1.0f) - u2);
+		wc = s * u2;
+	}
+};
+
+#pragma mark square mappings
+
+template<typename T, int ALIGN>
+void qOrthonormalBasis(const qVector3_T<T, ALIGN> &n, qVector3_T<T, ALIGN> &tangent, qVector3_T<T, ALIGN> &bitangent)
+{
+	qSampleKernel<T>::Basis(n.x, n.y, n.z, tangent.x, tangent.y, tangent.z, bitangent.x, bitangent.y, bitangent.z);
+}
+
+template<typename T, int ALIGN>
+qVector3_T<T, ALIGN> qLocalToWorld(const qVector3_T<T, ALIGN> &local, const qVector3_T<T, ALIGN> &n)
+{
+	qVector3_T<T, ALIGN> tangent, bitangent;
+	qOrthonormalBasis(n, tangent, bitangent);
+	return tangent * local.x + bitangent * local.y + n * local.z;
+}
+
+template<typename T, int ALIGN>
+qVector3_T<T, ALIGN> qSquareToSphere(const qVector2_T<T, ALIGN> &u)
+{
+	qVector3_T<T, ALIGN> result;
+	qSampleKernel<T>::Sphere(u.x, u.y, result.x, result.y, result.z);
+	return result;
+}
+
+template<typename T, int ALIGN>
+qVector2_T<T, ALIGN> qSquareToDisk(const qVector2_T<T, ALIGN> &u)
+{
+	qVector2_T<T, ALIGN> result;
+	qSampleKernel<T>::Disk(u.x, u.y, result.x, result.y);
+	return result;
+}
+
+template<typename T, int ALIGN>
+qVector3_T<T, ALIGN> qSquareToCosineHemisphere(const qVector2_T<T, ALIGN> &u, const qVector3_T<T, ALIGN> &normal)
+{
+	qVector3_T<T, ALIGN> local;
+	qSampleKernel<T>::CosineHemisphere(u.x, u.y, local.x, local.y, local.z);
+	return qLocalToWorld(local, normal);
+}
+
+template<typename T, int ALIGN>
+qVector3_T<T, ALIGN> qSquareToCone(const qVector2_T<T, ALIGN> &u, const qVector3_T<T, ALIGN> &axis, const T cosHalfAngle)
+{
+	qVector3_T<T, ALIGN> local;
+	qSampleKernel<T>::Cone(u.x, u.y, cosHalfAngle, local.x, local.y, local.z);
+	return qLocalToWorld(local, axis);
+}
+
+template<typename T, int ALIGN, int TRI_ALIGN>
+qVector3_T<T, ALIGN> qSquareToTriangle(const qVector2_T<T, ALIGN> &u, const qTriangle_T<qVector3_T<T, ALIGN>, TRI_ALIGN> &tri)
+{
+	T wa, wb, wc;
+	qSampleKernel<T>::Triangle(u.x, u.y, wa, wb, wc);
+	return tri.a * wa + tri.b * wb + tri.c * wc;
+}
+
+#pragma mark random points
+
+//white noise versions on the calling engine; the fills draw their uniforms in bulk and map a packet at a time
+
+qVector3 qRandomOnSphere(qRandomEngine &engine);
+qVector3 qRandomInBall(qRandomEngine &engine);
+qVector2 qRandomInDisk(qRandomEngine &engine);
+qVector3 qRandomCosineHemisphere(qRandomEngine &engine, const qVector3 &normal);
+qVector3 qRandomInCone(qRandomEngine &engine, const qVector3 &axis, const float cosHalfAngle);
+qVector3 qRandomOnTriangle(qRandomEngine &engine, const qTriangle3 &tri);
+
+//a quad is split along a-c, and the halves picked in proportion to their area
+qVector3 qRandomOnQuad(qRandomEngine &engine, const qQuad3 &quad);
+
+void qRandomFillOnSphere(qRandomEngine &engine, qVector3* out, const int count);
+void qRandomFillInBall(qRandomEngine &engine, qVector3* out, const int count);
+void qRandomFillInDisk(qRandomEngine &engine, qVector2* out, const int count);
+void qRandomFillCosineHemisphere(qRandomEngine &engine, qVector3* out, const int count, const qVector3 &normal);
+void qRandomFillInCone(qRandomEngine &engine, qVector3* out, const int count, const qVector3 &axis, const float cosHalfAngle);
+void qRandomFillOnTriangle(qRandomEngine &engine, qVector3* out, const int count, const qTriangle3 &tri);
+void qRandomFillOnQuad(qRandomEngine &engine, qVector3* out, const int count, const qQuad3 &quad);
+
+#endif // __Q_SAMPLING_H__
@@ -0,0 +1,466 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_SPATIAL_HASH_H__
+#define __Q_SPATIAL_HASH_H__
+
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include "qCore.h"
+#include "qVector3.h"
+#include "qValueHash.h"
+
+/*
+ points carrying a value, bucketed into cubic cells keyed by quantized position. the cells sit in one flat open addressing
+ table, linear probing at most half full, and each holds the head of an intrusive list through the entries, so insert,
+ remove and move cost one probe plus the walk of one cell. queries visit every cell overlapping the query box and test
+ the entries in it; a cell size near the usual query radius keeps a radius query to 27 cells. cell coordinates wrap at
+ 2^21 per axis, which can only add candidates that the distance test then rejects. handles stay valid until removed.
+*/
+
+template<typename T>
+class qSpatialHash
+{
+public:
+	
+	typedef int Handle;
+	static constexpr Handle InvalidHandle = -1;
+	
+	explicit qSpatialHash(const float _cellSize = 1.0f)
+	: live(0)
+	, freeList(InvalidHandle)
+	, occupied(0)
+	{
+		SetCellSize(_cellSize);
+	}
+	
+	//rebuckets everything already inserted
+	void SetCellSize(const float _cellSize)
+	{
+		qASSERT(_cellSize > 0.0f);
+		cellSize = _cellSize;
+		inverseCellSize = 1.0 / double(cellSize);
+		for(Handle h = 0; h < Handle(positions.size()); ++h)
+		{
+			if(slotOf[h] >= 0)
+			{
+				cellOf[h] = Key(positions[h]);
+			}
+		}
+		Rehash(int(slots.size()));
+	}
+	
+	float CellSize() const
+	{
+		return cellSize;
+	}
+	
+	int Count() const
+	{
+		return live;
+	}
+	
+	void Reserve(const int entries)
+	{
+		positions.reserve(entries);
+		values.reserve(entries);
+		next.reserve(entries);
+		slotOf.reserve(entries);
+		cellOf.reserve(entries);
+	}
+	
+	void Clear()
+	{
+		positions.clear();
+		values.clear();
+		next.clear();
+		slotOf.clear();
+		cellOf.clear();
+		live = 0;
+		freeList = InvalidHandle;
+		Rehash(0);
+	}
+	
+#pragma mark entries
+	
+	Handle Insert(const qVector3 &position, const T &value)
+	{
+		Handle h;
+		if(freeList != InvalidHandle)
+		{
+			h = freeList;
+			freeList = next[h];
+			positions[h] = position;
+			values[h] = value;
+		}
+		else
+		{
+			h = Handle(positions.size());
+			positions.push_back(position);
+			values.push_back(value);
+			next.push_back(InvalidHandle);
+			slotOf.push_back(-1);
+			cellOf.push_back(0);
+		}
+		cellOf[h] = Key(position);
+		Link(h);
+		++live;
+		return h;
+	}
+	
+	void Remove(const Handle h)
+	{
+		qASSERT(IsValid(h));
+		Unlink(h);
+		slotOf[h] = -1;
+		values[h] = T();
+		next[h] = freeList;
+		freeList = h;
+		--live;
+	}
+	
+	//an entry that stays in its cell only has its position updated
+	void Move(const Handle h, const qVector3 &position)
+	{
+		qASSERT(IsValid(h));
+		positions[h] = position;
+		const uint64_t key = Key(position);
+		if(key != cellOf[h])
+		{
+			Unlink(h);
+			slotOf[h] = -1;
+			cellOf[h] = key;
+			Link(h);
+		}
+	}
+	
+	bool IsValid(const Handle h) const
+	{
+		return h >= 0 && h < Handle(positions.size()) && slotOf[h] >= 0;
+	}
+	
+	const qVector3& Position(const Handle h) const
+	{
+		return positions[h];
+	}
+	
+	const T& Value(const Handle h) const
+	{
+		return values[h];
+	}
+	
+	T& Value(const Handle h)
+	{
+		return values[h];
+	}
+	
+#pragma mark queries
+	
+	//visit(value, position) for every entry within radius of center
+	template<typename VISIT>
+	void ForEachInRadius(const qVector3 &center, const float radius, VISIT visit) const
+	{
+		//local copies of the arrays, which a visit writing to some other container can't be assumed to leave alone
+		const qVector3* position = positions.data();
+		const T* value = values.data();
+		const float radiusSq = radius * radius;
+		ForEachCandidate(center - qVector3(radius), center + qVector3(radius), [&](const Handle h)
+		{
+			const qVector3 d = position[h] - center;
+			if(d.x * d.x + d.y * d.y + d.z * d.z <= radiusSq)
+			{
+				visit(value[h], position[h]);
+			}
+		});
+	}
+	
+	//visit(value, position) for every entry inside [min, max]
+	template<typename VISIT>
+	void ForEachInAABB(const qVector3 &min, const qVector3 &max, VISIT visit) const
+	{
+		const qVector3* position = positions.data();
+		const T* value = values.data();
+		ForEachCandidate(min, max, [&](const Handle h)
+		{
+			const qVector3 &p = position[h];
+			if(p.x >= min.x && p.y >= min.y && p.z >= min.z && p.x <= max.x && p.y <= max.y && p.z <= max.z)
+			{
+				visit(value[h], p);
+			}
+		});
+	}
+	
+	//append the values found. every candidate is written and the count only moves on a hit, so the about one in two
+	//misses don't cost a mispredicted branch each
+	void QueryRadius(const qVector3 &center, const float radius, std::vector<T> &out) const
+	{
+		const qVector3* position = positions.data();
+		const T* value = values.data();
+		const float radiusSq = radius * radius;
+		Appender append(out);
+		ForEachCandidate(center - qVector3(radius), center + qVector3(radius), [&](const Handle h)
+		{
+			const qVector3 d = position[h] - center;
+			append(value[h], d.x * d.x + d.y * d.y + d.z * d.z <= radiusSq);
+		});
+	}
+	
+	void QueryAABB(const qVector3 &min, const qVector3 &max, std::vector<T> &out) const
+	{
+		const qVector3* position = positions.data();
+		const T* value = values.data();
+		Appender append(out);
+		ForEachCandidate(min, max, [&](const Handle h)
+		{
+			const qVector3 &p = position[h];
+			append(value[h], (p.x >= min.x) & (p.y >= min.y) & (p.z >= min.z) & (p.x <= max.x) & (p.y <= max.y) & (p.z <= max.z));
+		});
+	}
+	
+	//one radius query per center, packed: the values found for centers[i] are out[offsets[i]] to out[offsets[i + 1] - 1].
+	//an entry sitting at a center is found by its own query. the queries run in cell order, so neighbouring queries
+	//share cached cells and entries, then the results are put back in center order
+	void QueryRadius(const qVector3* centers, const int count, const float radius, std::vector<int> &offsets, std::vector<T> &out) const
+	{
+		std::vector<std::pair<uint64_t, int>> order(count);
+		for(int i = 0; i < count; ++i)
+		{
+			order[i] = std::make_pair(Key(centers[i]), i);
+		}
+		std::sort(order.begin(), order.end());
+		
+		std::vector<T> found;
+		std::vector<int> start(count);
+		offsets.assign(count + 1, 0);
+		for(const std::pair<uint64_t, int> &query : order)
+		{
+			start[query.second] = int(found.size());
+			QueryRadius(centers[query.second], radius, found);
+			offsets[query.second + 1] = int(found.size()) - start[query.second];
+		}
+		
+		for(int i = 0; i < count; ++i)
+		{
+			offsets[i + 1] += offsets[i];
+		}
+		out.resize(found.size());
+		for(int i = 0; i < count; ++i)
+		{
+			std::copy(found.begin() + start[i], found.begin() + start[i] + (offsets[i + 1] - offsets[i]), out.begin() + offsets[i]);
+		}
+	}
+	
+private:
+	
+	struct Slot
+	{
+		uint64_t key;
+		Handle head;
+	};
+	
+	//collects results in a small local buffer, flushed to the output vector when full and when done
+	class Appender
+	{
+	public:
+		
+		explicit Appender(std::vector<T> &_out)
+		: out(_out)
+		, count(0)
+		{
+		}
+		
+		~Appender()
+		{
+			out.insert(out.end(), buffer, buffer + count);
+		}
+		
+		void operator()(const T &value, const bool keep)
+		{
+			buffer[count] = value;
+			count += int(keep);
+			if(count == Size)
+			{
+				out.insert(out.end(), buffer, buffer + Size);
+				count = 0;
+			}
+		}
+		
+	private:
+		
+		static constexpr int Size = 64;
+		
+		std::vector<T> &out;
+		T buffer[Size];
+		int count;
+	};
+	
+	static constexpr uint64_t EmptyKey = ~0ull;
+	static constexpr int CellBits = 21;
+	static constexpr uint64_t CellMask = (1ull << CellBits) - 1;
+	
+	std::vector<Slot> slots;
+	std::vector<qVector3> positions;
+	std::vector<T> values;
+	std::vector<Handle> next;
+	std::vector<int> slotOf;
+	std::vector<uint64_t> cellOf;
+	float cellSize;
+	double inverseCellSize;
+	int live;
+	Handle freeList;
+	int occupied;
+	
+	int64_t Cell(const float coordinate) const
+	{
+		return qValueHash::Quantize(coordinate, inverseCellSize);
+	}
+	
+	static uint64_t Key(const int64_t x, const int64_t y, const int64_t z)
+	{
+		return (uint64_t(x) & CellMask) | ((uint64_t(y) & CellMask) << CellBits) | ((uint64_t(z) & CellMask) << (2 * CellBits));
+	}
+	
+	uint64_t Key(const qVector3 &position) const
+	{
+		return Key(Cell(position.x), Cell(position.y), Cell(position.z));
+	}
+	
+	//Fibonacci hashing; the top bits of the product are the best mixed
+	int Home(const uint64_t key) const
+	{
+		return int(((key * 0x9E3779B97F4A7C15ull) >> 32) & uint64_t(slots.size() - 1));
+	}
+	
+	int FindOrAdd(const uint64_t key)
+	{
+		if(2 * (occupied + 1) > int(slots.size()))
+		{
+			Rehash(2 * live + 2);
+		}
+		const int mask = int(slots.size()) - 1;
+		int s = Home(key);
+		while(slots[s].key != key && slots[s].key != EmptyKey)
+		{
+			s = (s + 1) & mask;
+		}
+		if(slots[s].key == EmptyKey)
+		{
+			slots[s].key = key;
+			slots[s].head = InvalidHandle;
+			++occupied;
+		}
+		return s;
+	}
+	
+	void Link(const Handle h)
+	{
+		const int s = FindOrAdd(cellOf[h]);
+		next[h] = slots[s].head;
+		slots[s].head = h;
+		slotOf[h] = s;
+	}
+	
+	void Unlink(const Handle h)
+	{
+		Handle* link = &slots[slotOf[h]].head;
+		while(*link != h)
+		{
+			link = &next[*link];
+		}
+		*link = next[h];
+	}
+	
+	//rebuilds the table from the live entries with room for at least cells cells, dropping cells emptied by removes.
+	//never smaller than the live entries need, so relinking them can't grow the table again part way through
+	void Rehash(const int cells)
+	{
+		int capacity = 16;
+		while(capacity < 2 * qMax(cells, live))
+		{
+			capacity *= 2;
+		}
+		slots.assign(capacity, Slot{ EmptyKey, InvalidHandle });
+		occupied = 0;
+		for(Handle h = 0; h < Handle(positions.size()); ++h)
+		{
+			if(slotOf[h] >= 0)
+			{
+				Link(h);
+			}
+		}
+	}
+	
+	//every entry in the cells overlapping [min, max]; a box covering more cells than there are entries scans the entries
+	template<typename VISIT>
+	void ForEachCandidate(const qVector3 &min, const qVector3 &max, VISIT visit) const
+	{
+		const int64_t x0 = Cell(min.x), y0 = Cell(min.y), z0 = Cell(min.z);
+		const int64_t x1 = Cell(max.x), y1 = Cell(max.y), z1 = Cell(max.z);
+		
+		//cells run out to +-2^62 and NaN sits at INT64_MIN, so the spans are taken in double where they can't overflow
+		const double limit = double(CellMask);
+		const double spanX = double(x1) - double(x0);
+		const double spanY = double(y1) - double(y0);
+		const double spanZ = double(z1) - double(z0);
+		const double cells = (spanX + 1.0) * (spanY + 1.0) * (spanZ + 1.0);
+		if(!(spanX < limit && spanY < limit && spanZ < limit) || cells > double(live))
+		{
+			const int* entrySlot = slotOf.data();
+			const Handle end = Handle(positions.size());
+			for(Handle h = 0; h < end; ++h)
+			{
+				if(entrySlot[h] >= 0)
+				{
+					visit(h);
+				}
+			}
+			return;
+		}
+		
+		const Slot* table = slots.data();
+		const Handle* link = next.data();
+		const int mask = int(slots.size()) - 1;
+		for(int64_t z = z0; z <= z1; ++z)
+		{
+			for(int64_t y = y0; y <= y1; ++y)
+			{
+				for(int64_t x = x0; x <= x1; ++x)
+				{
+					const uint64_t key = Key(x, y, z);
+					int s = Home(key);
+					while(table[s].key != key && table[s].key != EmptyKey)
+					{
+						s = (s + 1) & mask;
+					}
+					for(Handle h = table[s].head; h != InvalidHandle; h = link[h])
+					{
+						visit(h);
+					}
+				}
+			}
+		}
+	}
+};
+
+#endif //__Q_SPATIAL_HASH_H__
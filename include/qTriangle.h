@@ -26,6 +26,7 @@ SOFTWARE.
 #include "qCore.h"
 #include "qVector4.h"
 #include <iostream>
+#include <type_traits>
 
 template<typename T, int ALIGN>
 class qTriangle_T
@@ -44,27 +45,18 @@ public:
         T t[3];
     };
     
-    qTriangle_T(T _a, T _b, T _c)
+    constexpr qTriangle_T(T _a, T _b, T _c)
     : a(_a)
     , b(_b)
     , c(_c)
     {}
 	
-    qTriangle_T(const qTriangle_T& tri)
-    : a(tri.a)
-    , b(tri.b)
-    , c(tri.c)
-    {}
-    
-    qTriangle_T()
+    constexpr qTriangle_T()
     : a(T(0))
     , b(T(0))
     , c(T(0))
     {}
     
-    ~qTriangle_T()
-    {}
-
 #pragma mark getters
     
     T operator[](int pos) const
@@ -73,16 +65,6 @@ public:
         return t[pos];
     }
     
-#pragma mark assignment
-    
-    qTriangle_T& operator=(const qTriangle_T &rhs)
-    { 
-        a = rhs.a;
-        b = rhs.b;
-        c = rhs.c;
-        return *this;
-    }
-    
 #pragma mark util
     
 	friend std::ostream& operator<<(std::ostream& out, const qTriangle_T& tri)
@@ -104,4 +86,14 @@ typedef qTriangle_T<qVector4d, 8> 	qTriangle4d;
 typedef qTriangle_T<qVector4, 4> 	qTriangle4;
 typedef qTriangle_T<qVector4h, 2> 	qTriangle4h;
 
+static_assert(std::is_trivially_copyable<qTriangle2>::value, "qTriangle2 must be trivially copyable");
+static_assert(std::is_standard_layout<qTriangle2>::value, "qTriangle2 must be standard layout");
+static_assert(sizeof(qTriangle2) == 3 * sizeof(qVector2), "qTriangle2 must be tightly packed");
+static_assert(std::is_trivially_copyable<qTriangle3>::value, "qTriangle3 must be trivially copyable");
+static_assert(std::is_standard_layout<qTriangle3>::value, "qTriangle3 must be standard layout");
+static_assert(sizeof(qTriangle3) == 3 * sizeof(qVector3), "qTriangle3 must be tightly packed");
+static_assert(std::is_trivially_copyable<qTriangle4>::value, "qTriangle4 must be trivially copyable");
+static_assert(std::is_standard_layout<qTriangle4>::value, "qTriangle4 must be standard layout");
+static_assert(sizeof(qTriangle4) == 3 * sizeof(qVector4), "qTriangle4 must be tightly packed");
+
 #endif // __Q_TRIANGLE_H__
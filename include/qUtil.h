@@ -24,10 +24,43 @@ SOFTWARE.
 #define __Q_UTIL_H__
 
 #import "math.h"
+#include <string.h>
+#include "qHash.h"
 
 typedef unsigned int qHashType;
-qHashType qHash(const char* key, unsigned int len);
-qHashType qHash(const char* key);
+
+//qHash64's two halves folded together. constexpr, so ids can be case labels and checked apart with static_assert;
+//outside constant expressions they call qHash64
+constexpr qHashType qHash(const char* key, unsigned int len)
+{
+    const uint64_t hash = qHASH_CONSTANT_EVALUATED() ? qHash64Constexpr(key, len) : qHash64(key, len);
+    return qHashType(hash ^ (hash >> 32));
+}
+
+constexpr qHashType qHash(const char* key)
+{
+    unsigned int length = 0;
+    if(qHASH_CONSTANT_EVALUATED())
+    {
+        while(key[length] != 0)
+        {
+            ++length;
+        }
+    }
+    else
+    {
+        length = (unsigned int)strlen(key);
+    }
+    return qHash(key, length);
+}
+
+//"someName"_qhash == qHash("someName"); always the constant expression path, so assign it to a constexpr to be
+//sure no hashing is left for run time
+constexpr qHashType operator"" _qhash(const char* key, size_t len)
+{
+    const uint64_t hash = qHash64Constexpr(key, len);
+    return qHashType(hash ^ (hash >> 32));
+}
 
 unsigned int qPowerOfTwo(unsigned int val);
 bool qIsPowerOfTwo(unsigned int val);
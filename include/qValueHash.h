@@ -0,0 +1,220 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_VALUE_HASH_H__
+#define __Q_VALUE_HASH_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <type_traits>
+#include "qHash.h"
+#include "qVector2.h"
+#include "qVector3.h"
+#include "qVector4.h"
+#include "qVectorN.h"
+#include "qRGBA.h"
+#include "qMatrix2.h"
+#include "qMatrix3.h"
+#include "qMatrix4.h"
+#include "qAffine.h"
+
+/*
+ hash and equality functors for the value types, for std::unordered_map and friends:
+ 
+	std::unordered_map<qVector3, int, qHasher<qVector3>, qEqual<qVector3>> exact;
+	std::unordered_map<qVector3, int, qQuantizedHasher<qVector3>, qQuantizedEqual<qVector3>> welded(64, qQuantizedHasher<qVector3>(0.001f), qQuantizedEqual<qVector3>(0.001f));
+ 
+ qHasher hashes component values, with -0 and 0 hashing alike to match ==. the quantized pair treats values in the
+ same epsilon sized cell as equal; values a hair apart on either side of a cell edge land in different cells, so weld
+ with neighbour lookups (see qSpatialHash) when that matters.
+*/
+
+//a value type's components as a flat array
+template<typename VALUE>
+struct qValueComponents;
+
+template<typename T, int N, int ALIGN>
+struct qValueComponents<qVectorN_T<T, N, ALIGN>>
+{
+	typedef T Component;
+	enum { Count = N };
+	static const T* Data(const qVectorN_T<T, N, ALIGN> &value) { return value.v; }
+};
+
+template<typename T>
+struct qValueComponents<qRGBA<T>>
+{
+	typedef T Component;
+	enum { Count = 4 };
+	static const T* Data(const qRGBA<T> &value) { return value.rgba; }
+};
+
+template<typename T, int N, int M>
+struct qValueComponents<qMatrixNxM_T<T, N, M>>
+{
+	typedef T Component;
+	enum { Count = N * M };
+	static const T* Data(const qMatrixNxM_T<T, N, M> &value) { return value.m; }
+};
+
+template<typename T>
+struct qValueComponents<qAffine3x4_T<T>>
+{
+	typedef T Component;
+	enum { Count = 12 };
+	static const T* Data(const qAffine3x4_T<T> &value) { return value.m; }
+};
+
+//one multiply-xor round per component; floats go through double, exact for every element type, with -0 folded into 0
+struct qValueHash
+{
+	template<typename T>
+	static uint64_t Bits(const T value)
+	{
+		if(std::is_integral<T>::value)
+		{
+			return uint64_t(value);
+		}
+		const double d = double(value);
+		if(d == 0.0)
+		{
+			return 0;
+		}
+		uint64_t bits;
+		memcpy(&bits, &d, sizeof(bits));
+		return bits;
+	}
+	
+	//the index of the epsilon cell holding value; a truncate and correct, since floor is a libm call below SSE4.1.
+	//the conversion is undefined past int64_t, so huge values and infinities share the outermost cells and NaN gets
+	//one of its own that no number reaches
+	template<typename T>
+	static int64_t Quantize(const T value, const double inverseEpsilon)
+	{
+		static constexpr double Limit = 4611686018427387904.0;
+		
+		double scaled = double(value) * inverseEpsilon;
+		if(scaled != scaled)
+		{
+			return INT64_MIN;
+		}
+		scaled = scaled < -Limit ? -Limit : (scaled > Limit ? Limit : scaled);
+		const int64_t truncated = int64_t(scaled);
+		return truncated - int64_t(scaled < double(truncated));
+	}
+	
+	static uint64_t Combine(const uint64_t hash, const uint64_t bits)
+	{
+		return qWyHash::Mix(hash ^ bits, qWyHash::Secret[1]);
+	}
+};
+
+template<typename VALUE>
+struct qHasher
+{
+	size_t operator()(const VALUE &value) const
+	{
+		typedef qValueComponents<VALUE> Components;
+		const typename Components::Component* v = Components::Data(value);
+		uint64_t hash = qWyHash::Secret[0];
+		for(int i = 0; i < Components::Count; ++i)
+		{
+			hash = qValueHash::Combine(hash, qValueHash::Bits(v[i]));
+		}
+		return size_t(hash);
+	}
+};
+
+template<typename VALUE>
+struct qEqual
+{
+	bool operator()(const VALUE &a, const VALUE &b) const
+	{
+		typedef qValueComponents<VALUE> Components;
+		const typename Components::Component* va = Components::Data(a);
+		const typename Components::Component* vb = Components::Data(b);
+		for(int i = 0; i < Components::Count; ++i)
+		{
+			if(!(va[i] == vb[i]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+template<typename VALUE>
+struct qQuantizedHasher
+{
+	static constexpr float DefaultEpsilon = 1e-4f;
+	
+	double inverseEpsilon;
+	
+	explicit qQuantizedHasher(const float epsilon = DefaultEpsilon)
+	: inverseEpsilon(1.0 / double(epsilon))
+	{
+		qASSERT(epsilon > 0.0f);
+	}
+	
+	size_t operator()(const VALUE &value) const
+	{
+		typedef qValueComponents<VALUE> Components;
+		const typename Components::Component* v = Components::Data(value);
+		uint64_t hash = qWyHash::Secret[0];
+		for(int i = 0; i < Components::Count; ++i)
+		{
+			hash = qValueHash::Combine(hash, uint64_t(qValueHash::Quantize(v[i], inverseEpsilon)));
+		}
+		return size_t(hash);
+	}
+};
+
+template<typename VALUE>
+struct qQuantizedEqual
+{
+	double inverseEpsilon;
+	
+	explicit qQuantizedEqual(const float epsilon = qQuantizedHasher<VALUE>::DefaultEpsilon)
+	: inverseEpsilon(1.0 / double(epsilon))
+	{
+		qASSERT(epsilon > 0.0f);
+	}
+	
+	bool operator()(const VALUE &a, const VALUE &b) const
+	{
+		typedef qValueComponents<VALUE> Components;
+		const typename Components::Component* va = Components::Data(a);
+		const typename Components::Component* vb = Components::Data(b);
+		for(int i = 0; i < Components::Count; ++i)
+		{
+			if(qValueHash::Quantize(va[i], inverseEpsilon) != qValueHash::Quantize(vb[i], inverseEpsilon))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+#endif //__Q_VALUE_HASH_H__
@@ -0,0 +1,303 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_VECTOR3X_H__
+#define __Q_VECTOR3X_H__
+
+#include "qCore.h"
+#include "qPacket.h"
+#include "qVector3.h"
+
+/*
+ W qVector3's held as one register per component
+ x [ x0 x1 x2 x3 ... ]
+ y [ y0 y1 y2 y3 ... ]
+ z [ z0 z1 z2 z3 ... ]
+*/
+
+template<int W>
+class qVector3x_T
+{
+public:
+	
+	typedef qFloatx_T<W> Float;
+	typedef qMaskx_T<W> Mask;
+	
+	Float x;
+	Float y;
+	Float z;
+	
+	qVector3x_T(const Float &_x, const Float &_y, const Float &_z)
+	: x(_x)
+	, y(_y)
+	, z(_z)
+	{}
+	
+	//every lane set to the same vector
+	qVector3x_T(const qVector3 &vec)
+	: x(vec.x)
+	, y(vec.y)
+	, z(vec.z)
+	{}
+	
+	qVector3x_T()
+	: x(0.0f)
+	, y(0.0f)
+	, z(0.0f)
+	{}
+	
+	//W tightly packed qVector3's
+	static qVector3x_T Load(const qVector3* vecs)
+	{
+		qVector3x_T temp;
+		Float::Ops::Load3(vecs->v, temp.x.r, temp.y.r, temp.z.r);
+		return temp;
+	}
+	
+	void Store(qVector3* vecs) const
+	{
+		Float::Ops::Store3(vecs->v, x.r, y.r, z.r);
+	}
+	
+#pragma mark getters
+	
+	qVector3 operator[](int lane) const
+	{
+		return qVector3(x[lane], y[lane], z[lane]);
+	}
+	
+#pragma mark addition
+	
+	qVector3x_T operator+(const Float &t) const
+	{
+		return qVector3x_T(x + t, y + t, z + t);
+	}
+	
+	qVector3x_T operator+(const qVector3x_T &rhs) const
+	{
+		return qVector3x_T(x + rhs.x, y + rhs.y, z + rhs.z);
+	}
+	
+	qVector3x_T& operator+=(const Float &t)
+	{
+		x += t;
+		y += t;
+		z += t;
+		return *this;
+	}
+	
+	qVector3x_T& operator+=(const qVector3x_T &rhs)
+	{
+		x += rhs.x;
+		y += rhs.y;
+		z += rhs.z;
+		return *this;
+	}
+	
+#pragma mark subtraction
+	
+	qVector3x_T operator-(const Float &t) const
+	{
+		return qVector3x_T(x - t, y - t, z - t);
+	}
+	
+	qVector3x_T operator-(const qVector3x_T &rhs) const
+	{
+		return qVector3x_T(x - rhs.x, y - rhs.y, z - rhs.z);
+	}
+	
+	qVector3x_T& operator-=(const Float &t)
+	{
+		x -= t;
+		y -= t;
+		z -= t;
+		return *this;
+	}
+	
+	qVector3x_T& operator-=(const qVector3x_T &rhs)
+	{
+		x -= rhs.x;
+		y -= rhs.y;
+		z -= rhs.z;
+		return *this;
+	}
+	
+#pragma mark negation
+	
+	qVector3x_T operator-() const
+	{
+		return qVector3x_T(-x, -y, -z);
+	}
+	
+#pragma mark multiplication
+	
+	qVector3x_T operator*(const Float &t) const
+	{
+		return qVector3x_T(x * t, y * t, z * t);
+	}
+	
+	qVector3x_T operator*(const qVector3x_T &rhs) const
+	{
+		return qVector3x_T(x * rhs.x, y * rhs.y, z * rhs.z);
+	}
+	
+	qVector3x_T& operator*=(const Float &t)
+	{
+		x *= t;
+		y *= t;
+		z *= t;
+		return *this;
+	}
+	
+	qVector3x_T& operator*=(const qVector3x_T &rhs)
+	{
+		x *= rhs.x;
+		y *= rhs.y;
+		z *= rhs.z;
+		return *this;
+	}
+	
+#pragma mark division
+	
+	qVector3x_T operator/(const Float &t) const
+	{
+		return qVector3x_T(x / t, y / t, z / t);
+	}
+	
+	qVector3x_T operator/(const qVector3x_T &rhs) const
+	{
+		return qVector3x_T(x / rhs.x, y / rhs.y, z / rhs.z);
+	}
+	
+	qVector3x_T& operator/=(const Float &t)
+	{
+		x /= t;
+		y /= t;
+		z /= t;
+		return *this;
+	}
+	
+	qVector3x_T& operator/=(const qVector3x_T &rhs)
+	{
+		x /= rhs.x;
+		y /= rhs.y;
+		z /= rhs.z;
+		return *this;
+	}
+	
+#pragma mark util
+	
+	//lanes of zero length come out as nan, there is no per lane assert
+	void Normalize()
+	{
+		*this /= Length();
+	}
+	
+	Float Length() const
+	{
+		return qVector3x_T::Length(*this);
+	}
+	
+	static qVector3x_T Normalize(const qVector3x_T &v)
+	{
+		return v / Length(v);
+	}
+	
+	static Float Dot(const qVector3x_T &v1, const qVector3x_T &v2)
+	{
+		return Float::MulAdd(v1.z, v2.z, Float::MulAdd(v1.y, v2.y, v1.x * v2.x));
+	}
+	
+	static qVector3x_T Cross(const qVector3x_T &v1, const qVector3x_T &v2)
+	{
+		return qVector3x_T(
+			(v1.y * v2.z) - (v1.z * v2.y),
+			(v1.z * v2.x) - (v1.x * v2.z),
+			(v1.x * v2.y) - (v1.y * v2.x)
+		);
+	}
+	
+	static Float Length(const qVector3x_T &v)
+	{
+		return Float::Sqrt(Dot(v, v));
+	}
+	
+	static qVector3x_T Abs(const qVector3x_T &v)
+	{
+		return qVector3x_T(
+			Float::Abs(v.x),
+			Float::Abs(v.y),
+			Float::Abs(v.z)
+		);
+	}
+	
+	static qVector3x_T Max(const qVector3x_T &v1, const qVector3x_T &v2)
+	{
+		return qVector3x_T(
+			Float::Max(v1.x, v2.x),
+			Float::Max(v1.y, v2.y),
+			Float::Max(v1.z, v2.z)
+		);
+	}
+	
+	static qVector3x_T Min(const qVector3x_T &v1, const qVector3x_T &v2)
+	{
+		return qVector3x_T(
+			Float::Min(v1.x, v2.x),
+			Float::Min(v1.y, v2.y),
+			Float::Min(v1.z, v2.z)
+		);
+	}
+	
+	//lanes of v1 where mask is set, otherwise lanes of v2
+	static qVector3x_T Select(const Mask &mask, const qVector3x_T &v1, const qVector3x_T &v2)
+	{
+		return qVector3x_T(
+			Float::Select(mask, v1.x, v2.x),
+			Float::Select(mask, v1.y, v2.y),
+			Float::Select(mask, v1.z, v2.z)
+		);
+	}
+	
+#pragma mark reduction
+	
+	qVector3 HorizontalAdd() const
+	{
+		return qVector3(x.HorizontalAdd(), y.HorizontalAdd(), z.HorizontalAdd());
+	}
+	
+	qVector3 HorizontalMin() const
+	{
+		return qVector3(x.HorizontalMin(), y.HorizontalMin(), z.HorizontalMin());
+	}
+	
+	qVector3 HorizontalMax() const
+	{
+		return qVector3(x.HorizontalMax(), y.HorizontalMax(), z.HorizontalMax());
+	}
+};
+
+typedef qVector3x_T<4> qVector3x4;
+typedef qVector3x_T<8> qVector3x8;
+typedef qVector3x_T<qPACKET_WIDTH> qVector3xN;
+
+#endif // __Q_VECTOR3X_H__
@@ -0,0 +1,515 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_VECTOR_N_H__
+#define __Q_VECTOR_N_H__
+
+#include <math.h>
+#include <type_traits>
+#include "qCore.h"
+#include "qSIMD.h"
+#include "qUtil.h"
+#include <iostream>
+
+#pragma mark unrolling
+
+//calls f(0) .. f(N - 1) with the index known at compile time, so fixed-size loops leave no loop behind
+template<int I, int N>
+struct qUnroll_T
+{
+	template<typename F>
+	static inline void Run(const F &f)
+	{
+		f(I);
+		qUnroll_T<I + 1, N>::Run(f);
+	}
+};
+
+template<int N>
+struct qUnroll_T<N, N>
+{
+	template<typename F>
+	static inline void Run(const F&)
+	{
+	}
+};
+
+#pragma mark kernels
+
+//element-wise kernels on N contiguous elements; the float specialization takes a register at a time when SIMD is available
+template<typename T, int N>
+struct qVectorNKernel
+{
+	static inline void Add(T* out, const T* a, const T* b)		{ qUnroll_T<0, N>::Run([&](int i) { out[i] = a[i] + b[i]; }); }
+	static inline void Sub(T* out, const T* a, const T* b)		{ qUnroll_T<0, N>::Run([&](int i) { out[i] = a[i] - b[i]; }); }
+	static inline void Mul(T* out, const T* a, const T* b)		{ qUnroll_T<0, N>::Run([&](int i) { out[i] = a[i] * b[i]; }); }
+	static inline void Div(T* out, const T* a, const T* b)		{ qUnroll_T<0, N>::Run([&](int i) { out[i] = a[i] / b[i]; }); }
+	static inline void Scale(T* out, const T* a, const T s)		{ qUnroll_T<0, N>::Run([&](int i) { out[i] = a[i] * s; }); }
+	static inline void Divide(T* out, const T* a, const T s)	{ qUnroll_T<0, N>::Run([&](int i) { out[i] = a[i] / s; }); }
+	static inline void Offset(T* out, const T* a, const T s)	{ qUnroll_T<0, N>::Run([&](int i) { out[i] = a[i] + s; }); }
+	
+	static inline T Dot(const T* a, const T* b)
+	{
+		T sum = T(0);
+		qUnroll_T<0, N>::Run([&](int i) { sum += a[i] * b[i]; });
+		return sum;
+	}
+};
+
+#if qSIMD_ENABLED
+template<int N>
+struct qVectorNKernel<float, N>
+{
+	enum { Full = N & ~3 };
+	
+	template<typename OP>
+	static inline void Binary(float* out, const float* a, const float* b, const OP &op)
+	{
+		qUnroll_T<0, Full / 4>::Run([&](int i) { qSIMD::Store(out + i * 4, op(qSIMD::Load(a + i * 4), qSIMD::Load(b + i * 4))); });
+		qUnroll_T<Full, N>::Run([&](int i) { out[i] = op(a[i], b[i]); });
+	}
+	
+	template<typename OP>
+	static inline void Unary(float* out, const float* a, const float s, const OP &op)
+	{
+		const qSIMD::float4 splat = qSIMD::Splat(s);
+		qUnroll_T<0, Full / 4>::Run([&](int i) { qSIMD::Store(out + i * 4, op(qSIMD::Load(a + i * 4), splat)); });
+		qUnroll_T<Full, N>::Run([&](int i) { out[i] = op(a[i], s); });
+	}
+	
+	static inline void Add(float* out, const float* a, const float* b)		{ Binary(out, a, b, qVectorNAdd()); }
+	static inline void Sub(float* out, const float* a, const float* b)		{ Binary(out, a, b, qVectorNSub()); }
+	static inline void Mul(float* out, const float* a, const float* b)		{ Binary(out, a, b, qVectorNMul()); }
+	static inline void Div(float* out, const float* a, const float* b)		{ Binary(out, a, b, qVectorNDiv()); }
+	static inline void Scale(float* out, const float* a, const float s)		{ Unary(out, a, s, qVectorNMul()); }
+	static inline void Divide(float* out, const float* a, const float s)	{ Unary(out, a, s, qVectorNDiv()); }
+	static inline void Offset(float* out, const float* a, const float s)	{ Unary(out, a, s, qVectorNAdd()); }
+	
+	static inline float Dot(const float* a, const float* b)
+	{
+		float sum = 0.0f;
+		if(Full > 0)
+		{
+			qSIMD::float4 acc = qSIMD::Splat(0.0f);
+			qUnroll_T<0, Full / 4>::Run([&](int i) { acc = qSIMD::MulAdd(qSIMD::Load(a + i * 4), qSIMD::Load(b + i * 4), acc); });
+			sum = qSIMD::HorizontalAdd(acc);
+		}
+		qUnroll_T<Full, N>::Run([&](int i) { sum += a[i] * b[i]; });
+		return sum;
+	}
+	
+private:
+	
+	struct qVectorNAdd
+	{
+		qSIMD::float4 operator()(const qSIMD::float4 a, const qSIMD::float4 b) const	{ return qSIMD::Add(a, b); }
+		float operator()(const float a, const float b) const							{ return a + b; }
+	};
+	
+	struct qVectorNSub
+	{
+		qSIMD::float4 operator()(const qSIMD::float4 a, const qSIMD::float4 b) const	{ return qSIMD::Sub(a, b); }
+		float operator()(const float a, const float b) const							{ return a - b; }
+	};
+	
+	struct qVectorNMul
+	{
+		qSIMD::float4 operator()(const qSIMD::float4 a, const qSIMD::float4 b) const	{ return qSIMD::Mul(a, b); }
+		float operator()(const float a, const float b) const							{ return a * b; }
+	};
+	
+	struct qVectorNDiv
+	{
+		qSIMD::float4 operator()(const qSIMD::float4 a, const qSIMD::float4 b) const	{ return qSIMD::Div(a, b); }
+		float operator()(const float a, const float b) const							{ return a / b; }
+	};
+};
+#endif
+
+#pragma mark storage
+
+template<typename T, int N, int ALIGN = sizeof(T)>
+class qVectorN_T;
+
+//the elements and constructors of qVectorN_T; sizes 2, 3 and 4 specialize it with named x/y/z/w members and the
+//statics that only mean something at that size, and qVector2_T/3_T/4_T are those sizes
+template<typename T, int N, int ALIGN>
+class qVectorNBase_T
+{
+public:
+	
+	T v[N];
+	
+	constexpr qVectorNBase_T()
+	: v()
+	{}
+	
+	explicit constexpr qVectorNBase_T(const T f)
+	: v()
+	{
+		for(int i = 0; i < N; ++i)
+		{
+			v[i] = f;
+		}
+	}
+	
+	template<typename... REST>
+	constexpr qVectorNBase_T(const T a, const T b, const REST... rest)
+	: v{ a, b, T(rest)... }
+	{
+		static_assert(sizeof...(REST) + 2 == N, "qVectorN_T needs exactly N elements");
+	}
+};
+
+template<typename T, int ALIGN>
+class qVectorNBase_T<T, 2, ALIGN>
+{
+public:
+	
+	typedef qVectorN_T<T, 2, ALIGN> Vector;
+	
+	union
+	{
+		struct
+		{
+			T x;
+			T y;
+		} __attribute__ ((aligned (ALIGN)));
+		
+		T v[2];
+	};
+	
+	constexpr qVectorNBase_T(T _x, T _y)
+	: x(_x)
+	, y(_y)
+	{}
+	
+	constexpr qVectorNBase_T(T _f)
+	: x(_f)
+	, y(_f)
+	{}
+	
+	constexpr qVectorNBase_T()
+	: x(T(0))
+	, y(T(0))
+	{}
+	
+	Vector Perpendicular() const
+	{
+		return Vector(-y, x);
+	}
+};
+
+template<typename T, int ALIGN>
+class qVectorNBase_T<T, 3, ALIGN>
+{
+public:
+	
+	typedef qVectorN_T<T, 3, ALIGN> Vector;
+	
+	union
+	{
+		struct
+		{
+			T x;
+			T y;
+			T z;
+		} __attribute__ ((aligned (ALIGN)));
+		
+		T v[3];
+	};
+	
+	constexpr qVectorNBase_T(T _x, T _y, T _z)
+	: x(_x)
+	, y(_y)
+	, z(_z)
+	{}
+	
+	constexpr qVectorNBase_T(T _f)
+	: x(_f)
+	, y(_f)
+	, z(_f)
+	{}
+	
+	constexpr qVectorNBase_T()
+	: x(T(0))
+	, y(T(0))
+	, z(T(0))
+	{}
+	
+	Vector Perpendicular() const
+	{
+		//there are an infinite number of perpendicular vectors to a 3d vector;
+		//this just provides a consistent way to find one, such that the dot product is zero
+		Vector p(-y, x, T(0));
+		
+		//on the chance x & y are both 0
+		if (p.Length() == T(0))
+		{
+			p = Vector(-z, T(0), T(0));
+			qASSERTM(p.Length() != T(0), "Asking for perpendicular vector to 0,0,0");
+		}
+		
+		return p;
+	}
+	
+	static Vector Cross(const Vector &v1, const Vector &v2)
+	{
+		return Vector(
+			(v1.y * v2.z) - (v1.z * v2.y),
+			(v1.z * v2.x) - (v1.x * v2.z),
+			(v1.x * v2.y) - (v1.y * v2.x)
+		);
+	}
+	
+	static Vector RotateAroundAxis(Vector p, T theta, Vector axis)
+	{
+		Vector q(0);
+		Vector r = Vector::Normalize(axis);
+		
+		T costheta = cos(theta);
+		T sintheta = sin(theta);
+
+		q.x += (costheta + (1 - costheta) * r.x * r.x) * p.x;
+		q.x += ((1 - costheta) * r.x * r.y - r.z * sintheta) * p.y;
+		q.x += ((1 - costheta) * r.x * r.z + r.y * sintheta) * p.z;
+
+		q.y += ((1 - costheta) * r.x * r.y + r.z * sintheta) * p.x;
+		q.y += (costheta + (1 - costheta) * r.y * r.y) * p.y;
+		q.y += ((1 - costheta) * r.y * r.z - r.x * sintheta) * p.z;
+
+		q.z += ((1 - costheta) * r.x * r.z - r.y * sintheta) * p.x;
+		q.z += ((1 - costheta) * r.y * r.z + r.x * sintheta) * p.y;
+		q.z += (costheta + (1 - costheta) * r.z * r.z) * p.z;
+
+		return q;
+	}
+};
+
+template<typename T, int ALIGN>
+class qVectorNBase_T<T, 4, ALIGN>
+{
+public:
+	
+	typedef qVectorN_T<T, 4, ALIGN> Vector;
+	
+	union
+	{
+		struct
+		{
+			T x;
+			T y;
+			T z;
+			T w;
+		} __attribute__ ((aligned (ALIGN)));
+		
+		T v[4];
+	};
+	
+	constexpr qVectorNBase_T(T _x, T _y, T _z, T _w)
+	: x(_x)
+	, y(_y)
+	, z(_z)
+	, w(_w)
+	{}
+	
+	constexpr qVectorNBase_T(T _f)
+	: x(_f)
+	, y(_f)
+	, z(_f)
+	, w(_f)
+	{}
+	
+	constexpr qVectorNBase_T(const qVectorN_T<T, 3, ALIGN> &vec, const T _w)
+	: x(vec.x)
+	, y(vec.y)
+	, z(vec.z)
+	, w(_w)
+	{}
+	
+	constexpr qVectorNBase_T()
+	: x(T(0))
+	, y(T(0))
+	, z(T(0))
+	, w(T(0))
+	{}
+	
+	qVectorN_T<T, 3, ALIGN> XYZ() const
+	{
+		return qVectorN_T<T, 3, ALIGN>(x, y, z);
+	}
+};
+
+#pragma mark vector
+
+//N elements of T in one array; every operator is unrolled at compile time and goes through qVectorNKernel
+template<typename T, int N, int ALIGN>
+class qVectorN_T : public qVectorNBase_T<T, N, ALIGN>
+{
+public:
+	
+	static_assert(N > 0, "qVectorN_T needs at least one element");
+	
+	typedef qVectorNBase_T<T, N, ALIGN> Base;
+	typedef T Element;
+	typedef qVectorNKernel<T, N> Kernel;
+	enum { Size = N };
+	
+	using Base::Base;
+	using Base::v;
+	
+	static qVectorN_T Load(const T* p)
+	{
+		qVectorN_T out;
+		qUnroll_T<0, N>::Run([&](int i) { out.v[i] = p[i]; });
+		return out;
+	}
+	
+	void Store(T* p) const
+	{
+		qUnroll_T<0, N>::Run([&](int i) { p[i] = v[i]; });
+	}
+	
+#pragma mark getters
+	
+	T& operator[](int pos)
+	{
+		qASSERT(pos < N);
+		return v[pos];
+	}
+	
+	T operator[](int pos) const
+	{
+		qASSERT(pos < N);
+		return v[pos];
+	}
+	
+#pragma mark comparison
+	
+	bool operator==(const qVectorN_T &rhs) const
+	{
+		bool equal = true;
+		qUnroll_T<0, N>::Run([&](int i) { equal = equal && (v[i] == rhs.v[i]); });
+		return equal;
+	}
+	
+	bool operator!=(const qVectorN_T &rhs) const
+	{
+		return !(*this == rhs);
+	}
+	
+#pragma mark arithmetic
+	
+	qVectorN_T operator+(const T t) const						{ qVectorN_T temp; Kernel::Offset(temp.v, v, t); return temp; }
+	qVectorN_T operator+(const qVectorN_T &rhs) const			{ qVectorN_T temp; Kernel::Add(temp.v, v, rhs.v); return temp; }
+	qVectorN_T operator-(const T t) const						{ qVectorN_T temp; Kernel::Offset(temp.v, v, -t); return temp; }
+	qVectorN_T operator-(const qVectorN_T &rhs) const			{ qVectorN_T temp; Kernel::Sub(temp.v, v, rhs.v); return temp; }
+	qVectorN_T operator*(const T t) const						{ qVectorN_T temp; Kernel::Scale(temp.v, v, t); return temp; }
+	qVectorN_T operator*(const qVectorN_T &rhs) const			{ qVectorN_T temp; Kernel::Mul(temp.v, v, rhs.v); return temp; }
+	qVectorN_T operator/(const T t) const						{ qASSERT(t != T(0)); qVectorN_T temp; Kernel::Divide(temp.v, v, t); return temp; }
+	qVectorN_T operator/(const qVectorN_T &rhs) const			{ qVectorN_T temp; Kernel::Div(temp.v, v, rhs.v); return temp; }
+	qVectorN_T operator-() const								{ qVectorN_T temp; Kernel::Scale(temp.v, v, T(-1)); return temp; }
+	
+	qVectorN_T& operator+=(const T t)							{ Kernel::Offset(v, v, t); return *this; }
+	qVectorN_T& operator+=(const qVectorN_T &rhs)				{ Kernel::Add(v, v, rhs.v); return *this; }
+	qVectorN_T& operator-=(const T t)							{ Kernel::Offset(v, v, -t); return *this; }
+	qVectorN_T& operator-=(const qVectorN_T &rhs)				{ Kernel::Sub(v, v, rhs.v); return *this; }
+	qVectorN_T& operator*=(const T t)							{ Kernel::Scale(v, v, t); return *this; }
+	qVectorN_T& operator*=(const qVectorN_T &rhs)				{ Kernel::Mul(v, v, rhs.v); return *this; }
+	qVectorN_T& operator/=(const T t)							{ qASSERT(t != T(0)); Kernel::Divide(v, v, t); return *this; }
+	qVectorN_T& operator/=(const qVectorN_T &rhs)				{ Kernel::Div(v, v, rhs.v); return *this; }
+	
+#pragma mark util
+	
+	void Normalize()
+	{
+		T length = Length();
+		qASSERTM(length != T(0), "Normalizing a zero length vector");
+		(*this) /= length;
+	}
+	
+	T Length() const
+	{
+		return T(sqrt(Dot(*this, *this)));
+	}
+	
+	static qVectorN_T Normalize(const qVectorN_T &vec)
+	{
+		qVectorN_T temp = vec;
+		temp.Normalize();
+		return temp;
+	}
+	
+	static T Dot(const qVectorN_T &v1, const qVectorN_T &v2)
+	{
+		return Kernel::Dot(v1.v, v2.v);
+	}
+	
+	static T Length(const qVectorN_T &vec)
+	{
+		return vec.Length();
+	}
+	
+	static qVectorN_T Abs(const qVectorN_T &vec)
+	{
+		qVectorN_T temp;
+		qUnroll_T<0, N>::Run([&](int i) { temp.v[i] = qAbs(vec.v[i]); });
+		return temp;
+	}
+	
+	static qVectorN_T Max(const qVectorN_T &v1, const qVectorN_T &v2)
+	{
+		qVectorN_T temp;
+		qUnroll_T<0, N>::Run([&](int i) { temp.v[i] = qMax(v1.v[i], v2.v[i]); });
+		return temp;
+	}
+	
+	static qVectorN_T Min(const qVectorN_T &v1, const qVectorN_T &v2)
+	{
+		qVectorN_T temp;
+		qUnroll_T<0, N>::Run([&](int i) { temp.v[i] = qMin(v1.v[i], v2.v[i]); });
+		return temp;
+	}
+	
+	friend std::ostream& operator<<(std::ostream& out, const qVectorN_T& vec)
+	{
+		out << "[";
+		for(int i = 0; i < N; ++i)
+		{
+			out << (i ? ", " : "") << vec.v[i];
+		}
+		out << "]";
+		return out;
+	}
+} __attribute__ ((aligned (ALIGN)));
+
+typedef qVectorN_T<float, 5> qVector5;
+typedef qVectorN_T<float, 6> qVector6;
+typedef qVectorN_T<float, 8> qVector8;
+typedef qVectorN_T<double, 5> qVector5d;
+typedef qVectorN_T<double, 6> qVector6d;
+typedef qVectorN_T<double, 8> qVector8d;
+
+static_assert(std::is_trivially_copyable<qVector8>::value, "qVector8 must be trivially copyable");
+static_assert(std::is_standard_layout<qVector8>::value, "qVector8 must be standard layout");
+
+#endif // __Q_VECTOR_N_H__
@@ -0,0 +1,675 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_VECTOR_SOA_H__
+#define __Q_VECTOR_SOA_H__
+
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+#include "qCore.h"
+#include "qSIMD.h"
+#include "qVector2.h"
+#include "qVector3.h"
+#include "qVector4.h"
+
+#pragma mark stream operations
+
+//each op works on a scalar of any type, and on a whole register of floats when SIMD is available
+
+struct qSoAOp_Add
+{
+	template<typename T> static T Apply(const T a, const T b) { return a + b; }
+#if qSIMD_ENABLED
+	static qSIMD::float4 Apply(const qSIMD::float4 a, const qSIMD::float4 b) { return qSIMD::Add(a, b); }
+#endif
+};
+
+struct qSoAOp_Sub
+{
+	template<typename T> static T Apply(const T a, const T b) { return a - b; }
+#if qSIMD_ENABLED
+	static qSIMD::float4 Apply(const qSIMD::float4 a, const qSIMD::float4 b) { return qSIMD::Sub(a, b); }
+#endif
+};
+
+struct qSoAOp_Mul
+{
+	template<typename T> static T Apply(const T a, const T b) { return a * b; }
+#if qSIMD_ENABLED
+	static qSIMD::float4 Apply(const qSIMD::float4 a, const qSIMD::float4 b) { return qSIMD::Mul(a, b); }
+#endif
+};
+
+struct qSoAOp_Div
+{
+	template<typename T> static T Apply(const T a, const T b) { return a / b; }
+#if qSIMD_ENABLED
+	static qSIMD::float4 Apply(const qSIMD::float4 a, const qSIMD::float4 b) { return qSIMD::Div(a, b); }
+#endif
+};
+
+struct qSoAOp_Min
+{
+	template<typename T> static T Apply(const T a, const T b) { return qMin(a, b); }
+#if qSIMD_ENABLED
+	static qSIMD::float4 Apply(const qSIMD::float4 a, const qSIMD::float4 b) { return qSIMD::Min(a, b); }
+#endif
+};
+
+struct qSoAOp_Max
+{
+	template<typename T> static T Apply(const T a, const T b) { return qMax(a, b); }
+#if qSIMD_ENABLED
+	static qSIMD::float4 Apply(const qSIMD::float4 a, const qSIMD::float4 b) { return qSIMD::Max(a, b); }
+#endif
+};
+
+//count is always a multiple of qSIMD_WIDTH, see qVectorSoA_T::Capacity
+template<typename OP, typename T>
+void qSoABinary(T* out, const T* a, const T* b, const int count)
+{
+	for(int i = 0; i < count; ++i)
+	{
+		out[i] = OP::Apply(a[i], b[i]);
+	}
+}
+
+template<typename OP, typename T>
+void qSoABinary(T* out, const T* a, const T b, const int count)
+{
+	for(int i = 0; i < count; ++i)
+	{
+		out[i] = OP::Apply(a[i], b);
+	}
+}
+
+#if qSIMD_ENABLED
+template<typename OP>
+void qSoABinary(float* out, const float* a, const float* b, const int count)
+{
+	for(int i = 0; i < count; i += qSIMD_WIDTH)
+	{
+		qSIMD::Store(out + i, OP::Apply(qSIMD::Load(a + i), qSIMD::Load(b + i)));
+	}
+}
+
+template<typename OP>
+void qSoABinary(float* out, const float* a, const float b, const int count)
+{
+	qSIMD::float4 bb = qSIMD::Splat(b);
+	for(int i = 0; i < count; i += qSIMD_WIDTH)
+	{
+		qSIMD::Store(out + i, OP::Apply(qSIMD::Load(a + i), bb));
+	}
+}
+#endif
+
+template<typename T>
+void qSoAMulAdd(T* out, const T* a, const T* b, const int count)
+{
+	for(int i = 0; i < count; ++i)
+	{
+		out[i] += a[i] * b[i];
+	}
+}
+
+template<typename T>
+void qSoAMulSub(T* out, const T* a, const T* b, const int count)
+{
+	for(int i = 0; i < count; ++i)
+	{
+		out[i] -= a[i] * b[i];
+	}
+}
+
+template<typename T>
+void qSoASqrt(T* out, const T* a, const int count)
+{
+	for(int i = 0; i < count; ++i)
+	{
+		out[i] = sqrt(a[i]);
+	}
+}
+
+template<typename T>
+void qSoAAbs(T* out, const T* a, const int count)
+{
+	for(int i = 0; i < count; ++i)
+	{
+		out[i] = qAbs(a[i]);
+	}
+}
+
+//packed vectors of N components to and from N streams
+template<typename T>
+void qSoADeinterleave(T* const* streams, const int N, const T* in, const int count)
+{
+	for(int i = 0; i < count; ++i)
+	{
+		for(int k = 0; k < N; ++k)
+		{
+			streams[k][i] = in[i * N + k];
+		}
+	}
+}
+
+template<typename T>
+void qSoAInterleave(T* out, const T* const* streams, const int N, const int count)
+{
+	for(int i = 0; i < count; ++i)
+	{
+		for(int k = 0; k < N; ++k)
+		{
+			out[i * N + k] = streams[k][i];
+		}
+	}
+}
+
+#if qSIMD_ENABLED
+inline void qSoAMulAdd(float* out, const float* a, const float* b, const int count)
+{
+	for(int i = 0; i < count; i += qSIMD_WIDTH)
+	{
+		qSIMD::Store(out + i, qSIMD::MulAdd(qSIMD::Load(a + i), qSIMD::Load(b + i), qSIMD::Load(out + i)));
+	}
+}
+
+inline void qSoAMulSub(float* out, const float* a, const float* b, const int count)
+{
+	for(int i = 0; i < count; i += qSIMD_WIDTH)
+	{
+		qSIMD::Store(out + i, qSIMD::Sub(qSIMD::Load(out + i), qSIMD::Mul(qSIMD::Load(a + i), qSIMD::Load(b + i))));
+	}
+}
+
+inline void qSoASqrt(float* out, const float* a, const int count)
+{
+	for(int i = 0; i < count; i += qSIMD_WIDTH)
+	{
+		qSIMD::Store(out + i, qSIMD::Sqrt(qSIMD::Load(a + i)));
+	}
+}
+
+inline void qSoAAbs(float* out, const float* a, const int count)
+{
+	for(int i = 0; i < count; i += qSIMD_WIDTH)
+	{
+		qSIMD::Store(out + i, qSIMD::Abs(qSIMD::Load(a + i)));
+	}
+}
+
+inline void qSoADeinterleave(float* const* streams, const int N, const float* in, const int count)
+{
+	int i = 0;
+	if (N == 3)
+	{
+		for(; i + 4 <= count; i += 4)
+		{
+			qSIMD::float4 x, y, z;
+			qSIMD::Load3x4(in + i * 3, x, y, z);
+			qSIMD::Store(streams[0] + i, x);
+			qSIMD::Store(streams[1] + i, y);
+			qSIMD::Store(streams[2] + i, z);
+		}
+	}
+	else if (N == 4)
+	{
+		for(; i + 4 <= count; i += 4)
+		{
+			qSIMD::float4 x, y, z, w;
+			qSIMD::Load4x4(in + i * 4, x, y, z, w);
+			qSIMD::Store(streams[0] + i, x);
+			qSIMD::Store(streams[1] + i, y);
+			qSIMD::Store(streams[2] + i, z);
+			qSIMD::Store(streams[3] + i, w);
+		}
+	}
+	for(; i < count; ++i)
+	{
+		for(int k = 0; k < N; ++k)
+		{
+			streams[k][i] = in[i * N + k];
+		}
+	}
+}
+
+inline void qSoAInterleave(float* out, const float* const* streams, const int N, const int count)
+{
+	int i = 0;
+	if (N == 3)
+	{
+		for(; i + 4 <= count; i += 4)
+		{
+			qSIMD::Store3x4(out + i * 3, qSIMD::Load(streams[0] + i), qSIMD::Load(streams[1] + i), qSIMD::Load(streams[2] + i));
+		}
+	}
+	else if (N == 4)
+	{
+		for(; i + 4 <= count; i += 4)
+		{
+			qSIMD::Store4x4(out + i * 4, qSIMD::Load(streams[0] + i), qSIMD::Load(streams[1] + i), qSIMD::Load(streams[2] + i), qSIMD::Load(streams[3] + i));
+		}
+	}
+	for(; i < count; ++i)
+	{
+		for(int k = 0; k < N; ++k)
+		{
+			out[i * N + k] = streams[k][i];
+		}
+	}
+}
+#endif
+
+#pragma mark container
+
+/*
+ N component vectors stored as N separate streams, one per component, e.g. for N = 3
+ [ x0 x1 x2 x3 ... ]
+ [ y0 y1 y2 y3 ... ]
+ [ z0 z1 z2 z3 ... ]
+ streams are padded to a whole number of SIMD registers; the padding lanes are scratch
+*/
+
+template<typename T, int N>
+class qVectorSoA_T
+{
+public:
+	
+	qVectorSoA_T()
+	: data(NULL)
+	, count(0)
+	, capacity(0)
+	{}
+	
+	qVectorSoA_T(const int _count)
+	: data(NULL)
+	, count(0)
+	, capacity(0)
+	{
+		Resize(_count);
+	}
+	
+	~qVectorSoA_T()
+	{
+		free(data);
+	}
+	
+	qVectorSoA_T(const qVectorSoA_T &soa) = delete;
+	qVectorSoA_T& operator=(const qVectorSoA_T &rhs) = delete;
+	
+#pragma mark getters
+	
+	int Count() const
+	{
+		return count;
+	}
+	
+	int Capacity() const
+	{
+		return capacity;
+	}
+	
+	//count rounded up to a whole number of SIMD registers, the extent every operation works over
+	int Lanes() const
+	{
+		return (count + qSIMD_WIDTH - 1) & ~(qSIMD_WIDTH - 1);
+	}
+	
+	T* Stream(const int component)
+	{
+		qASSERT(component < N);
+		return data + component * capacity;
+	}
+	
+	const T* Stream(const int component) const
+	{
+		qASSERT(component < N);
+		return data + component * capacity;
+	}
+	
+	template<typename VEC>
+	VEC Get(const int index) const
+	{
+		qASSERT(index < count);
+		VEC vec;
+		for(int k = 0; k < N; ++k)
+		{
+			vec.v[k] = Stream(k)[index];
+		}
+		return vec;
+	}
+	
+#pragma mark setters
+	
+	template<typename VEC>
+	void Set(const int index, const VEC &vec)
+	{
+		qASSERT(index < count);
+		for(int k = 0; k < N; ++k)
+		{
+			Stream(k)[index] = vec.v[k];
+		}
+	}
+	
+	//the first min(old, new) count elements are kept; the elements after them, up to the padded lanes, are cleared to zero
+	void Resize(const int _count)
+	{
+		const int kept = count < _count ? count : _count;
+		count = _count;
+		int padded = Lanes();
+		if (padded > capacity)
+		{
+			void* mem = NULL;
+			int result = posix_memalign(&mem, 32, sizeof(T) * N * padded);
+			qASSERT(result == 0);
+			(void)result;
+			T* grown = (T*)mem;
+			for(int k = 0; k < N && kept > 0; ++k)
+			{
+				memcpy(grown + k * padded, Stream(k), sizeof(T) * kept);
+			}
+			free(data);
+			data = grown;
+			capacity = padded;
+		}
+		for(int k = 0; k < N && padded > kept; ++k)
+		{
+			memset(Stream(k) + kept, 0, sizeof(T) * (padded - kept));
+		}
+	}
+	
+#pragma mark conversion
+	
+	//array of count qVectorN_T's to and from the streams; tightly packed arrays of T (e.g. 12 byte qVector3) take the fast path
+	template<typename VEC>
+	void FromAoS(const VEC* in, const int _count)
+	{
+		Resize(_count);
+		if (count == 0)
+		{
+			return;
+		}
+		if constexpr (IsPacked<VEC>())
+		{
+			T* streams[N];
+			for(int k = 0; k < N; ++k)
+			{
+				streams[k] = Stream(k);
+			}
+			qSoADeinterleave(streams, N, in[0].v, count);
+		}
+		else
+		{
+			for(int i = 0; i < count; ++i)
+			{
+				for(int k = 0; k < N; ++k)
+				{
+					Stream(k)[i] = in[i].v[k];
+				}
+			}
+		}
+	}
+	
+	template<typename VEC>
+	void ToAoS(VEC* out) const
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		if constexpr (IsPacked<VEC>())
+		{
+			const T* streams[N];
+			for(int k = 0; k < N; ++k)
+			{
+				streams[k] = Stream(k);
+			}
+			qSoAInterleave(out[0].v, streams, N, count);
+		}
+		else
+		{
+			for(int i = 0; i < count; ++i)
+			{
+				for(int k = 0; k < N; ++k)
+				{
+					out[i].v[k] = Stream(k)[i];
+				}
+			}
+		}
+	}
+	
+#pragma mark addition
+	
+	qVectorSoA_T& operator+=(const T t)
+	{
+		for(int k = 0; k < N; ++k)
+		{
+			qSoABinary<qSoAOp_Add>(Stream(k), Stream(k), t, Lanes());
+		}
+		return *this;
+	}
+	
+	qVectorSoA_T& operator+=(const qVectorSoA_T &rhs)
+	{
+		qASSERT(rhs.count == count);
+		for(int k = 0; k < N; ++k)
+		{
+			qSoABinary<qSoAOp_Add>(Stream(k), Stream(k), rhs.Stream(k), Lanes());
+		}
+		return *this;
+	}
+	
+	static void Add(qVectorSoA_T &out, const qVectorSoA_T &v1, const qVectorSoA_T &v2)
+	{
+		Binary<qSoAOp_Add>(out, v1, v2);
+	}
+	
+#pragma mark subtraction
+	
+	qVectorSoA_T& operator-=(const T t)
+	{
+		for(int k = 0; k < N; ++k)
+		{
+			qSoABinary<qSoAOp_Sub>(Stream(k), Stream(k), t, Lanes());
+		}
+		return *this;
+	}
+	
+	qVectorSoA_T& operator-=(const qVectorSoA_T &rhs)
+	{
+		qASSERT(rhs.count == count);
+		for(int k = 0; k < N; ++k)
+		{
+			qSoABinary<qSoAOp_Sub>(Stream(k), Stream(k), rhs.Stream(k), Lanes());
+		}
+		return *this;
+	}
+	
+	static void Sub(qVectorSoA_T &out, const qVectorSoA_T &v1, const qVectorSoA_T &v2)
+	{
+		Binary<qSoAOp_Sub>(out, v1, v2);
+	}
+	
+#pragma mark multiplication
+	
+	qVectorSoA_T& operator*=(const T t)
+	{
+		for(int k = 0; k < N; ++k)
+		{
+			qSoABinary<qSoAOp_Mul>(Stream(k), Stream(k), t, Lanes());
+		}
+		return *this;
+	}
+	
+	qVectorSoA_T& operator*=(const qVectorSoA_T &rhs)
+	{
+		qASSERT(rhs.count == count);
+		for(int k = 0; k < N; ++k)
+		{
+			qSoABinary<qSoAOp_Mul>(Stream(k), Stream(k), rhs.Stream(k), Lanes());
+		}
+		return *this;
+	}
+	
+	static void Mul(qVectorSoA_T &out, const qVectorSoA_T &v1, const qVectorSoA_T &v2)
+	{
+		Binary<qSoAOp_Mul>(out, v1, v2);
+	}
+	
+#pragma mark division
+	
+	qVectorSoA_T& operator/=(const T t)
+	{
+		qASSERT(t != T(0));
+		for(int k = 0; k < N; ++k)
+		{
+			qSoABinary<qSoAOp_Div>(Stream(k), Stream(k), t, Lanes());
+		}
+		return *this;
+	}
+	
+	//padding lanes of rhs are zero, so they divide to inf/nan; they are never read back
+	qVectorSoA_T& operator/=(const qVectorSoA_T &rhs)
+	{
+		qASSERT(rhs.count == count);
+		for(int k = 0; k < N; ++k)
+		{
+			qSoABinary<qSoAOp_Div>(Stream(k), Stream(k), rhs.Stream(k), Lanes());
+		}
+		return *this;
+	}
+	
+	static void Div(qVectorSoA_T &out, const qVectorSoA_T &v1, const qVectorSoA_T &v2)
+	{
+		Binary<qSoAOp_Div>(out, v1, v2);
+	}
+	
+#pragma mark util
+	
+	void Normalize()
+	{
+		qVectorSoA_T<T, 1> length(count);
+		Length(length, *this);
+		for(int k = 0; k < N; ++k)
+		{
+			qSoABinary<qSoAOp_Div>(Stream(k), Stream(k), length.Stream(0), Lanes());
+		}
+	}
+	
+	//for N == 1 out may alias v1 or v2, the Resize keeps their elements
+	static void Dot(qVectorSoA_T<T, 1> &out, const qVectorSoA_T &v1, const qVectorSoA_T &v2)
+	{
+		qASSERT(v1.count == v2.count);
+		out.Resize(v1.count);
+		T* o = out.Stream(0);
+		qSoABinary<qSoAOp_Mul>(o, v1.Stream(0), v2.Stream(0), v1.Lanes());
+		for(int k = 1; k < N; ++k)
+		{
+			qSoAMulAdd(o, v1.Stream(k), v2.Stream(k), v1.Lanes());
+		}
+	}
+	
+	static void Length(qVectorSoA_T<T, 1> &out, const qVectorSoA_T &v)
+	{
+		Dot(out, v, v);
+		qSoASqrt(out.Stream(0), out.Stream(0), out.Lanes());
+	}
+	
+	static void Cross(qVectorSoA_T &out, const qVectorSoA_T &v1, const qVectorSoA_T &v2)
+	{
+		static_assert(N == 3, "Cross is only defined for 3 component vectors");
+		qASSERT(v1.count == v2.count);
+		qASSERT(&out != &v1 && &out != &v2);
+		out.Resize(v1.count);
+		for(int k = 0; k < 3; ++k)
+		{
+			int a = (k + 1) % 3;
+			int b = (k + 2) % 3;
+			T* o = out.Stream(k);
+			qSoABinary<qSoAOp_Mul>(o, v1.Stream(a), v2.Stream(b), out.Lanes());
+			qSoAMulSub(o, v1.Stream(b), v2.Stream(a), out.Lanes());
+		}
+	}
+	
+	static void Abs(qVectorSoA_T &out, const qVectorSoA_T &v)
+	{
+		if (&out != &v)
+		{
+			out.Resize(v.count);
+		}
+		for(int k = 0; k < N; ++k)
+		{
+			qSoAAbs(out.Stream(k), v.Stream(k), v.Lanes());
+		}
+	}
+	
+	static void Max(qVectorSoA_T &out, const qVectorSoA_T &v1, const qVectorSoA_T &v2)
+	{
+		Binary<qSoAOp_Max>(out, v1, v2);
+	}
+	
+	static void Min(qVectorSoA_T &out, const qVectorSoA_T &v1, const qVectorSoA_T &v2)
+	{
+		Binary<qSoAOp_Min>(out, v1, v2);
+	}
+	
+private:
+	
+	T* data;
+	int count;
+	int capacity;
+	
+	//VEC is N contiguous T's, so its array is one interleaved stream
+	template<typename VEC>
+	static constexpr bool IsPacked()
+	{
+		typedef typename std::remove_cv<typename std::remove_reference<decltype(std::declval<VEC>().v[0])>::type>::type E;
+		return std::is_same<E, T>::value && sizeof(VEC) == sizeof(T) * N;
+	}
+	
+	template<typename OP>
+	static void Binary(qVectorSoA_T &out, const qVectorSoA_T &v1, const qVectorSoA_T &v2)
+	{
+		qASSERT(v1.count == v2.count);
+		if (&out != &v1 && &out != &v2)
+		{
+			out.Resize(v1.count);
+		}
+		for(int k = 0; k < N; ++k)
+		{
+			qSoABinary<OP>(out.Stream(k), v1.Stream(k), v2.Stream(k), v1.Lanes());
+		}
+	}
+};
+
+typedef qVectorSoA_T<float, 1> qScalarSoA;
+typedef qVectorSoA_T<float, 2> qVector2SoA;
+typedef qVectorSoA_T<float, 3> qVector3SoA;
+typedef qVectorSoA_T<float, 4> qVector4SoA;
+
+typedef qVectorSoA_T<double, 1> qScalarSoAd;
+typedef qVectorSoA_T<double, 2> qVector2SoAd;
+typedef qVectorSoA_T<double, 3> qVector3SoAd;
+typedef qVectorSoA_T<double, 4> qVector4SoAd;
+
+#endif // __Q_VECTOR_SOA_H__
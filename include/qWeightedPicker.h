@@ -0,0 +1,266 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef __Q_WEIGHTED_PICKER_H__
+#define __Q_WEIGHTED_PICKER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "qCore.h"
+#include "qRandomEngine.h"
+#include "qRandomCounter.h"
+#include "qUtil.h"
+
+/*
+ weighted picks by Vose's alias method: an O(n) build, then every pick is one random word, one bucket and one compare,
+ however many entries there are. SetWeight only records the change; the tables are rebuilt once, by the next pick or
+ by an explicit Rebuild. call Rebuild before sharing a picker between threads, since picks are otherwise read only.
+*/
+
+template<typename T>
+class qWeightedPicker
+{
+public:
+	
+	qWeightedPicker()
+	: total(0.0)
+	, dirty(false)
+	{
+	}
+	
+	qWeightedPicker(const T* _items, const float* _weights, const int count)
+	{
+		Build(_items, _weights, count);
+	}
+	
+	void Build(const T* _items, const float* _weights, const int count)
+	{
+		items.assign(_items, _items + count);
+		weights.assign(_weights, _weights + count);
+		Rebuild();
+	}
+	
+	void Add(const T& item, const float weight)
+	{
+		qASSERT(weight >= 0.0f);
+		items.push_back(item);
+		weights.push_back(weight);
+		dirty = true;
+	}
+	
+	void SetWeight(const int index, const float weight)
+	{
+		qASSERT(index >= 0 && index < Count());
+		qASSERT(weight >= 0.0f);
+		weights[index] = weight;
+		dirty = true;
+	}
+	
+	float GetWeight(const int index) const
+	{
+		return weights[index];
+	}
+	
+	int Count() const
+	{
+		return int(items.size());
+	}
+	
+	const T& operator[](const int index) const
+	{
+		return items[index];
+	}
+	
+#pragma mark picks
+	
+	//the high half of the word picks a bucket by multiply-shift, the low half is the coin against its threshold
+	int PickIndex(const uint64_t word) const
+	{
+		Refresh();
+		qASSERT(!buckets.empty());
+		const uint32_t slot = uint32_t((uint64_t(uint32_t(word >> 32)) * buckets.size()) >> 32);
+		const Bucket& bucket = buckets[slot];
+		return uint32_t(word) < bucket.threshold ? int(slot) : bucket.alias;
+	}
+	
+	int PickIndex(qRandomEngine &engine) const
+	{
+		return PickIndex(engine.Next());
+	}
+	
+	int PickIndex(const qRandomCounter &counter, const uint64_t stream, const uint64_t index) const
+	{
+		uint32_t words[4];
+		counter.GeneratePick(stream, index, words);
+		return PickIndex((uint64_t(words[0]) << 32) | words[1]);
+	}
+	
+	const T& Pick(qRandomEngine &engine) const
+	{
+		return items[PickIndex(engine)];
+	}
+	
+	const T& Pick(const qRandomCounter &counter, const uint64_t stream, const uint64_t index) const
+	{
+		return items[PickIndex(counter, stream, index)];
+	}
+	
+	void PickIndices(qRandomEngine &engine, int* out, const int count) const
+	{
+		Refresh();
+		for(int i = 0; i < count; ++i)
+		{
+			out[i] = PickIndex(engine.Next());
+		}
+	}
+	
+	void Pick(qRandomEngine &engine, T* out, const int count) const
+	{
+		Refresh();
+		for(int i = 0; i < count; ++i)
+		{
+			out[i] = items[PickIndex(engine.Next())];
+		}
+	}
+	
+	int PickIndex() const
+	{
+		return PickIndex(qRandomEngine::Default());
+	}
+	
+	const T& Pick() const
+	{
+		return Pick(qRandomEngine::Default());
+	}
+	
+	void Pick(T* out, const int count) const
+	{
+		Pick(qRandomEngine::Default(), out, count);
+	}
+	
+#pragma mark build
+	
+	//Vose: scale the weights to a mean of one, then pair each short bucket with a tall entry that tops it up.
+	//the tables are a cache of the weights, so this only touches the mutable members and picks can call it
+	void Rebuild() const
+	{
+		const int count = Count();
+		qASSERT(count > 0);
+		
+		total = 0.0;
+		for(int i = 0; i < count; ++i)
+		{
+			total += weights[i];
+		}
+		qASSERT(total > 0.0);
+		
+		std::vector<double> scaled(count);
+		std::vector<int> small;
+		std::vector<int> large;
+		small.reserve(count);
+		large.reserve(count);
+		for(int i = 0; i < count; ++i)
+		{
+			scaled[i] = double(weights[i]) * count / total;
+			(scaled[i] < 1.0 ? small : large).push_back(i);
+		}
+		
+		buckets.resize(count);
+		while(!small.empty() && !large.empty())
+		{
+			const int s = small.back();
+			const int l = large.back();
+			small.pop_back();
+			
+			//the subtraction below can leave a short entry a rounding step outside [0, 1), and 2^32 doesn't fit the threshold
+			const double coin = qSaturate(scaled[s]);
+			buckets[s].threshold = coin < 1.0 ? uint32_t(coin * 4294967296.0) : 0xFFFFFFFFu;
+			buckets[s].alias = l;
+			
+			scaled[l] -= 1.0 - scaled[s];
+			if(scaled[l] < 1.0)
+			{
+				large.pop_back();
+				small.push_back(l);
+			}
+		}
+		
+		//whatever is left is full up to rounding; aliasing it to itself makes the coin irrelevant
+		for(size_t i = 0; i < large.size(); ++i)
+		{
+			buckets[large[i]].threshold = 0xFFFFFFFFu;
+			buckets[large[i]].alias = large[i];
+		}
+		for(size_t i = 0; i < small.size(); ++i)
+		{
+			buckets[small[i]].threshold = 0xFFFFFFFFu;
+			buckets[small[i]].alias = small[i];
+		}
+		
+		dirty = false;
+	}
+	
+	double TotalWeight() const
+	{
+		Refresh();
+		return total;
+	}
+	
+private:
+	
+	struct Bucket
+	{
+		uint32_t threshold;
+		int alias;
+	};
+	
+	std::vector<T> items;
+	std::vector<float> weights;
+	mutable std::vector<Bucket> buckets;
+	mutable double total;
+	mutable bool dirty;
+	
+	void Refresh() const
+	{
+		if(dirty)
+		{
+			Rebuild();
+		}
+	}
+};
+
+#pragma mark qPick
+
+template <class TYPE>
+const TYPE& qPick(qRandomEngine &engine, const qWeightedPicker<TYPE> &picker)
+{
+	return picker.Pick(engine);
+}
+
+template <class TYPE>
+const TYPE& qPick(const qWeightedPicker<TYPE> &picker)
+{
+	return picker.Pick();
+}
+
+#endif // __Q_WEIGHTED_PICKER_H__
@@ -0,0 +1,141 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "qHash.h"
+#include <string.h>
+
+//the run time loads; memcpy compiles to single unaligned little endian loads
+struct qHashMemory
+{
+	const uint8_t* p;
+	
+	uint64_t Byte(const size_t i) const
+	{
+		return p[i];
+	}
+	
+	uint64_t Read4(const size_t i) const
+	{
+		uint32_t v;
+		memcpy(&v, p + i, 4);
+		return v;
+	}
+	
+	uint64_t Read8(const size_t i) const
+	{
+		uint64_t v;
+		memcpy(&v, p + i, 8);
+		return v;
+	}
+};
+
+uint64_t qHash64(const void* key, const size_t length, const uint64_t seed)
+{
+	return qWyHash::Hash(qHashMemory{ static_cast<const uint8_t*>(key) }, length, seed);
+}
+
+#pragma mark stream
+
+void qHashStream::Reset(const uint64_t _seed)
+{
+	seed = qWyHash::Seed(_seed);
+	lane[0] = lane[1] = lane[2] = seed;
+	total = 0;
+	buffered = 0;
+}
+
+void qHashStream::Block48(const uint8_t* p)
+{
+	const qHashMemory block = { p };
+	lane[0] = qWyHash::Mix(block.Read8(0) ^ qWyHash::Secret[1], block.Read8(8) ^ lane[0]);
+	lane[1] = qWyHash::Mix(block.Read8(16) ^ qWyHash::Secret[2], block.Read8(24) ^ lane[1]);
+	lane[2] = qWyHash::Mix(block.Read8(32) ^ qWyHash::Secret[3], block.Read8(40) ^ lane[2]);
+}
+
+//qHash64 mixes a block whenever 48 or more bytes remain, so a full buffer can always be mixed straight away
+void qHashStream::Update(const void* data, size_t length)
+{
+	const uint8_t* p = static_cast<const uint8_t*>(data);
+	total += length;
+	
+	if(buffered > 0)
+	{
+		const size_t take = length < size_t(Block - buffered) ? length : size_t(Block - buffered);
+		memcpy(buffer + Tail + buffered, p, take);
+		buffered += int(take);
+		p += take;
+		length -= take;
+		if(buffered < Block)
+		{
+			return;
+		}
+		Block48(buffer + Tail);
+		memcpy(buffer, buffer + Block, Tail);
+		buffered = 0;
+	}
+	
+	if(length >= size_t(Block))
+	{
+		do
+		{
+			Block48(p);
+			p += Block;
+			length -= Block;
+		}
+		while(length >= size_t(Block));
+		memcpy(buffer, p - Tail, Tail);
+	}
+	
+	memcpy(buffer + Tail, p, length);
+	buffered = int(length);
+}
+
+uint64_t qHashStream::Finish() const
+{
+	const qHashMemory pending = { buffer + Tail };
+	uint64_t a, b;
+	if(total <= 16)
+	{
+		qWyHash::Short(pending, size_t(total), a, b);
+		return qWyHash::Final(a, b, seed, total);
+	}
+	
+	uint64_t mixed = lane[0];
+	if(total >= uint64_t(Block))
+	{
+		mixed ^= lane[1] ^ lane[2];
+	}
+	
+	//the tail reads may reach back into the Tail bytes kept from the last block
+	const qHashMemory tail = { buffer };
+	size_t p = Tail;
+	int i = buffered;
+	while(i > 16)
+	{
+		mixed = qWyHash::Mix(tail.Read8(p) ^ qWyHash::Secret[1], tail.Read8(p + 8) ^ mixed);
+		p += 16;
+		i -= 16;
+	}
+	a = tail.Read8(p + i - 16);
+	b = tail.Read8(p + i - 8);
+	return qWyHash::Final(a, b, mixed, total);
+}
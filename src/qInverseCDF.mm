@@ -0,0 +1,147 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "qInverseCDF.h"
+#include "qRandom.h"
+#include <math.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//the density is resampled this finely before integrating, so each fine step can treat the cdf as a straight line
+static const int kInverseCDFSteps = 4096;
+
+qInverseCDF::qInverseCDF(const float* density, const int count)
+{
+	qASSERT(count >= 2);
+	
+	std::vector<double> cdf(kInverseCDFSteps + 1);
+	cdf[0] = 0.0;
+	double previous = density[0];
+	for(int j = 1; j <= kInverseCDFSteps; ++j)
+	{
+		const double position = double(j) * double(count - 1) / double(kInverseCDFSteps);
+		const int knot = qMin(int(position), count - 2);
+		const double t = position - double(knot);
+		const double current = double(density[knot]) + (double(density[knot + 1]) - double(density[knot])) * t;
+		qASSERT(current >= 0.0);
+		cdf[j] = cdf[j - 1] + 0.5 * (previous + current);
+		previous = current;
+	}
+	const double total = cdf[kInverseCDFSteps];
+	qASSERT(total > 0.0);
+	
+	//the ends are where the support starts and stops, so zero density at either end is never drawn
+	int first = 0;
+	while(cdf[first + 1] <= 0.0)
+	{
+		++first;
+	}
+	int last = kInverseCDFSteps - 1;
+	while(cdf[last] >= total)
+	{
+		--last;
+	}
+	table[0] = float(first) / float(kInverseCDFSteps);
+	table[Size] = float(last + 1) / float(kInverseCDFSteps);
+	
+	int j = first;
+	for(int k = 1; k < Size; ++k)
+	{
+		const double target = total * double(k) / double(Size);
+		while(cdf[j + 1] < target)
+		{
+			++j;
+		}
+		const double width = cdf[j + 1] - cdf[j];
+		const double t = width > 0.0 ? (target - cdf[j]) / width : 0.0;
+		table[k] = float((double(j) + t) / double(kInverseCDFSteps));
+	}
+}
+
+void qInverseCDF::Fill(qRandomEngine &engine, float* out, const int count) const
+{
+	qRandomFill01(engine, out, count);
+	for(int i = 0; i < count; ++i)
+	{
+		out[i] = Map(out[i]);
+	}
+}
+
+template<typename DENSITY>
+static qInverseCDF qInverseCDFFrom(DENSITY density)
+{
+	const int count = 1025;
+	float samples[count];
+	for(int i = 0; i < count; ++i)
+	{
+		samples[i] = float(density(double(i) / double(count - 1)));
+	}
+	return qInverseCDF(samples, count);
+}
+
+const qInverseCDF& qInverseCDF::Exponential()
+{
+	static const qInverseCDF table = qInverseCDFFrom([](const double x)
+	{
+		return exp(-5.0 * x);
+	});
+	return table;
+}
+
+const qInverseCDF& qInverseCDF::Triangular()
+{
+	static const qInverseCDF table = qInverseCDFFrom([](const double x)
+	{
+		return 1.0 - fabs(2.0 * x - 1.0);
+	});
+	return table;
+}
+
+const qInverseCDF& qInverseCDF::LogNormal()
+{
+	static const qInverseCDF table = qInverseCDFFrom([](const double x)
+	{
+		if(x <= 0.0)
+		{
+			return 0.0;
+		}
+		const double z = log(x / 0.25) / 0.5;
+		return exp(-0.5 * z * z) / x;
+	});
+	return table;
+}
+
+const qInverseCDF* qInverseCDF::Intern(const float* density, const int count)
+{
+	static std::mutex lock;
+	static std::map<std::vector<float>, std::unique_ptr<qInverseCDF>> tables;
+	
+	std::lock_guard<std::mutex> guard(lock);
+	std::unique_ptr<qInverseCDF> &table = tables[std::vector<float>(density, density + count)];
+	if(!table)
+	{
+		table.reset(new qInverseCDF(density, count));
+	}
+	return table.get();
+}
@@ -0,0 +1,150 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "qLowDiscrepancy.h"
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+#pragma mark blue noise
+
+//Ulichney's void and cluster on a torus: relax a sparse random pattern until its tightest cluster is also its largest
+//void, rank those points by removing clusters, then rank the rest by filling voids
+static void qBlueNoiseBuild(uint16_t* ranks)
+{
+	const int size = 64;
+	const int count = size * size;
+	const float sigma = 1.5f;
+	
+	std::vector<float> kernel(count);
+	for(int y = 0; y < size; ++y)
+	{
+		for(int x = 0; x < size; ++x)
+		{
+			const int dx = qMin(x, size - x);
+			const int dy = qMin(y, size - y);
+			kernel[y * size + x] = expf(-float(dx * dx + dy * dy) / (2.0f * sigma * sigma));
+		}
+	}
+	
+	std::vector<float> energy(count, 0.0f);
+	std::vector<uint8_t> on(count, 0);
+	
+	auto splat = [&](const int p, const float sign)
+	{
+		const int px = p % size;
+		const int py = p / size;
+		for(int y = 0; y < size; ++y)
+		{
+			const float* row = &kernel[((y - py) & (size - 1)) * size];
+			for(int x = 0; x < size; ++x)
+			{
+				energy[y * size + x] += sign * row[(x - px) & (size - 1)];
+			}
+		}
+	};
+	
+	auto tightestCluster = [&]()
+	{
+		int best = -1;
+		for(int p = 0; p < count; ++p)
+		{
+			if(on[p] && (best < 0 || energy[p] > energy[best]))
+			{
+				best = p;
+			}
+		}
+		return best;
+	};
+	
+	auto largestVoid = [&]()
+	{
+		int best = -1;
+		for(int p = 0; p < count; ++p)
+		{
+			if(!on[p] && (best < 0 || energy[p] < energy[best]))
+			{
+				best = p;
+			}
+		}
+		return best;
+	};
+	
+	//fixed seed, so every build of the tile is identical
+	qRandomEngine engine(0xB10E0015Eull);
+	const int initial = count / 10;
+	for(int placed = 0; placed < initial; )
+	{
+		const int p = int(engine.NextBounded(count));
+		if(!on[p])
+		{
+			on[p] = 1;
+			splat(p, 1.0f);
+			++placed;
+		}
+	}
+	
+	//converges in a few hundred swaps; the cap only guards against a two point cycle
+	for(int pass = 0; pass < count; ++pass)
+	{
+		const int cluster = tightestCluster();
+		on[cluster] = 0;
+		splat(cluster, -1.0f);
+		
+		const int hole = largestVoid();
+		on[hole] = 1;
+		splat(hole, 1.0f);
+		if(hole == cluster)
+		{
+			break;
+		}
+	}
+	
+	const std::vector<float> relaxedEnergy = energy;
+	const std::vector<uint8_t> relaxedOn = on;
+	
+	for(int rank = initial - 1; rank >= 0; --rank)
+	{
+		const int cluster = tightestCluster();
+		on[cluster] = 0;
+		splat(cluster, -1.0f);
+		ranks[cluster] = uint16_t(rank);
+	}
+	
+	energy = relaxedEnergy;
+	on = relaxedOn;
+	for(int rank = initial; rank < count; ++rank)
+	{
+		const int hole = largestVoid();
+		on[hole] = 1;
+		splat(hole, 1.0f);
+		ranks[hole] = uint16_t(rank);
+	}
+}
+
+const uint16_t* qBlueNoiseTile()
+{
+	static uint16_t tile[64 * 64];
+	static const bool built = (qBlueNoiseBuild(tile), true);
+	(void)built;
+	return tile;
+}
@@ -0,0 +1,63 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "qParallel.h"
+#include "qCore.h"
+#include "qUtil.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+void qRunParallel(const int tasks, const std::function<void(int)> &body, const int threads)
+{
+	const int hardware = qMax(int(std::thread::hardware_concurrency()), 1);
+	const int workers = qMin(threads > 0 ? threads : hardware, tasks);
+	if(workers <= 1)
+	{
+		for(int i = 0; i < tasks; ++i)
+		{
+			body(i);
+		}
+		return;
+	}
+	
+	//workers claim tasks from a shared counter, so uneven slices balance themselves
+	std::atomic<int> next(0);
+	auto work = [&]()
+	{
+		for(int i = next++; i < tasks; i = next++)
+		{
+			body(i);
+		}
+	};
+	
+	std::vector<std::thread> pool;
+	pool.reserve(workers - 1);
+	for(int i = 1; i < workers; ++i)
+	{
+		pool.emplace_back(work);
+	}
+	work();
+	for(std::thread &thread : pool)
+	{
+		thread.join();
+	}
+}
@@ -23,50 +23,531 @@ SOFTWARE.
 #include "qRandom.h"
 #include "qCore.h"
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <math.h>
+#include <atomic>
 
-NSUInteger qRandom(const NSUInteger max)
+static std::atomic<uint64_t> sRandomSeed(0x9E3779B97F4A7C15ull);
+static std::atomic<uint32_t> sRandomThreadCount(0);
+
+static uint64_t qRandomMix(uint64_t z)
 {
-	float rand01 = float(rand()) / float(RAND_MAX);
-	float result = float(max) * rand01;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+uint64_t qRandomEngine::ThreadSeed()
+{
+	static thread_local uint32_t threadIndex = sRandomThreadCount++;
+	return qRandomMix(sRandomSeed.load() + qRandomMix(threadIndex));
+}
+
+qRandomEngine qRandomEngine::Root()
+{
+	return qRandomEngine(qRandomMix(sRandomSeed.load()));
+}
+
+NSUInteger qRandom(qRandomEngine &engine, const NSUInteger max)
+{
+	double rand01 = engine.NextDouble();
+	double result = double(max) * rand01;
     return NSUInteger(result);
 }
 
-NSUInteger qRandom(const NSUInteger min, const NSUInteger max)
+NSUInteger qRandom(qRandomEngine &engine, const NSUInteger min, const NSUInteger max)
 {
 	qASSERT(max >= min);
-	NSUInteger offset = qRandom(max - min);
+	NSUInteger offset = qRandom(engine, max - min);
 	return min + offset;
 }
 
 void qSeedRandom(int seed)
 {
-	srand(seed == 0 ? (uint)time(NULL) : seed);
+	sRandomSeed.store(seed == 0 ? (uint64_t)time(NULL) : (uint64_t)seed);
+	qRandomEngine::Default().Seed(qRandomEngine::ThreadSeed());
+}
+
+#pragma mark normal
+
+//Marsaglia and Tsang's 128 layer ziggurat. the layer index comes from the low 7 bits of a random word and the signed
+//offset from the high 25, so the two never share bits; about 98.8% of draws return from the first table compare
+struct qZiggurat
+{
+	enum { Layers = 128 };
+	
+	uint32_t k[Layers];
+	float w[Layers];
+	float f[Layers];
+	
+	static constexpr double R = 3.442619855899;
+	static constexpr double Area = 9.91256303526217e-3;
+	static constexpr double Scale = 16777216.0;
+	
+	qZiggurat()
+	{
+		double d = R;
+		double t = d;
+		const double q = Area / exp(-0.5 * d * d);
+		
+		k[0] = uint32_t((d / q) * Scale);
+		k[1] = 0;
+		w[0] = float(q / Scale);
+		w[Layers - 1] = float(d / Scale);
+		f[0] = 1.0f;
+		f[Layers - 1] = float(exp(-0.5 * d * d));
+		
+		for(int i = Layers - 2; i >= 1; --i)
+		{
+			d = sqrt(-2.0 * log(Area / d + exp(-0.5 * d * d)));
+			k[i + 1] = uint32_t((d / t) * Scale);
+			t = d;
+			f[i] = float(exp(-0.5 * d * d));
+			w[i] = float(d / Scale);
+		}
+	}
+	
+	static const qZiggurat& Get()
+	{
+		static const qZiggurat table;
+		return table;
+	}
+	
+	static int32_t Offset(const uint32_t bits)
+	{
+		return int32_t(bits) >> 7;
+	}
+	
+	static uint32_t Layer(const uint32_t bits)
+	{
+		return bits & (Layers - 1);
+	}
+	
+	bool Inside(const int32_t offset, const uint32_t layer) const
+	{
+		return uint32_t(offset < 0 ? -offset : offset) < k[layer];
+	}
+	
+	//the rare draws that land outside a layer's inner rectangle: the wedge test, or the base layer's tail
+	float Slow(qRandomEngine &engine, int32_t offset, uint32_t layer) const
+	{
+		while(true)
+		{
+			const float x = float(offset) * w[layer];
+			if(layer == 0)
+			{
+				float tx, ty;
+				do
+				{
+					tx = -logf(1.0f - engine.NextFloat()) * float(1.0 / R);
+					ty = -logf(1.0f - engine.NextFloat());
+				}
+				while(ty + ty < tx * tx);
+				return offset > 0 ? float(R) + tx : -float(R) - tx;
+			}
+			
+			if(f[layer] + engine.NextFloat() * (f[layer - 1] - f[layer]) < expf(-0.5f * x * x))
+			{
+				return x;
+			}
+			
+			const uint32_t bits = engine.Next32();
+			offset = Offset(bits);
+			layer = Layer(bits);
+			if(Inside(offset, layer))
+			{
+				return float(offset) * w[layer];
+			}
+		}
+	}
+	
+	float Sample(qRandomEngine &engine, const uint32_t bits) const
+	{
+		const int32_t offset = Offset(bits);
+		const uint32_t layer = Layer(bits);
+		if(Inside(offset, layer))
+		{
+			return float(offset) * w[layer];
+		}
+		return Slow(engine, offset, layer);
+	}
+};
+
+float qRandomGaussian(qRandomEngine &engine)
+{
+	return qZiggurat::Get().Sample(engine, engine.Next32());
+}
+
+float qRandomGaussian(qRandomEngine &engine, const float mean, const float stdDev)
+{
+	return mean + stdDev * qRandomGaussian(engine);
 }
 
-float qRandomGaussian(const float mean, const float stdDev)
-{    
-    const int iterations = 12;
-    float sum = 0.0f;
-    
-    for(int i = 0; i < iterations; ++i)
-    {
-        sum += qRandom(2.0f / iterations);
-    }
-    
-    sum -= 1.0f;
-    
-    return sum * stdDev * stdDev + mean;
+//Giles' single precision erfinv, a fixed cost polynomial on either side of w = 5
+static float qErfInv(const float x)
+{
+	float w = -logf((1.0f - x) * (1.0f + x));
+	
+	//x = +-1, e.g. a bound far enough out that erff rounds to 1; the polynomials lose the sign there
+	if(isinf(w))
+	{
+		return copysignf(HUGE_VALF, x);
+	}
+	
+	float p;
+	if(w < 5.0f)
+	{
+		w -= 2.5f;
+		p = 2.81022636e-08f;
+		p = 3.43273939e-07f + p * w;
+		p = -3.5233877e-06f + p * w;
+		p = -4.39150654e-06f + p * w;
+		p = 0.00021858087f + p * w;
+		p = -0.00125372503f + p * w;
+		p = -0.00417768164f + p * w;
+		p = 0.246640727f + p * w;
+		p = 1.50140941f + p * w;
+	}
+	else
+	{
+		w = sqrtf(w) - 3.0f;
+		p = -0.000200214257f;
+		p = 0.000100950558f + p * w;
+		p = 0.00134934322f + p * w;
+		p = -0.00367342844f + p * w;
+		p = 0.00573950773f + p * w;
+		p = -0.0076224613f + p * w;
+		p = 0.00943887047f + p * w;
+		p = 1.00167406f + p * w;
+		p = 2.83297682f + p * w;
+	}
+	return p * x;
 }
 
-int qRandomInt(const int count)
+qTruncatedGaussian::qTruncatedGaussian(const float _mean, const float _stdDev, const float _min, const float _max)
+: mean(_mean)
+, stdDev(_stdDev)
+, min(_min)
+, max(_max)
 {
-	return floor(qRandom((float)count));
+	qASSERT(max >= min);
+	qASSERT(stdDev > 0.0f);
+	
+	//cdf(x) = (1 + erf(x / sqrt 2)) / 2, so the bounds are kept in erf space and the halving and offset drop out
+	const float scale = float(M_SQRT1_2) / stdDev;
+	lo = erff((min - mean) * scale);
+	hi = erff((max - mean) * scale);
 }
 
-bool qRandomBool()
+float qTruncatedGaussian::Sample(qRandomEngine &engine) const
 {
-	return qRandom(0.0f, 1.0f) < 0.5f;
+	const float e = lo + engine.NextFloat() * (hi - lo);
+	const float result = mean + stdDev * float(M_SQRT2) * qErfInv(e);
+	return qMin(qMax(result, min), max);
 }
 
+void qTruncatedGaussian::Fill(qRandomEngine &engine, float* out, const int count) const
+{
+	qRandomFill(engine, out, count, lo, hi);
+	for(int i = 0; i < count; ++i)
+	{
+		const float result = mean + stdDev * float(M_SQRT2) * qErfInv(out[i]);
+		out[i] = qMin(qMax(result, min), max);
+	}
+}
+
+float qRandomTruncatedGaussian(qRandomEngine &engine, const float mean, const float stdDev, const float min, const float max)
+{
+	return qTruncatedGaussian(mean, stdDev, min, max).Sample(engine);
+}
+
+#pragma mark batch
+
+//sixteen xoshiro128** streams side by side, seeded from the engine; 32 bit lanes fill SSE, NEON and AVX registers alike,
+//and the multiplies by 5 and 9 are shifts and adds, so every step vectorizes across lanes
+struct qRandomLanes
+{
+	enum { Block = 16 };
+	
+	uint32_t s0[Block];
+	uint32_t s1[Block];
+	uint32_t s2[Block];
+	uint32_t s3[Block];
+	
+	explicit qRandomLanes(qRandomEngine &engine)
+	{
+		for(int l = 0; l < Block; ++l)
+		{
+			const uint64_t a = engine.Next();
+			const uint64_t b = engine.Next();
+			s0[l] = uint32_t(a);
+			s1[l] = uint32_t(a >> 32);
+			s2[l] = uint32_t(b);
+			s3[l] = uint32_t(b >> 32) | 1u;
+		}
+	}
+	
+	//one random word per lane
+	void Next(uint32_t* out)
+	{
+		for(int l = 0; l < Block; ++l)
+		{
+			uint32_t x = s1[l] + (s1[l] << 2);
+			x = (x << 7) | (x >> 25);
+			out[l] = x + (x << 3);
+			
+			const uint32_t t = s1[l] << 9;
+			s2[l] ^= s0[l];
+			s3[l] ^= s1[l];
+			s1[l] ^= s2[l];
+			s0[l] ^= s3[l];
+			s2[l] ^= t;
+			s3[l] = (s3[l] << 11) | (s3[l] >> 21);
+		}
+	}
+	
+	//[0, 1): 23 random bits under the exponent of 1.0 give [1, 2), then subtract 1
+	void Next(float* out)
+	{
+		uint32_t bits[Block];
+		Next(bits);
+		for(int i = 0; i < Block; ++i)
+		{
+			bits[i] = (bits[i] >> 9) | 0x3F800000u;
+		}
+		
+		memcpy(out, bits, sizeof(bits));
+		for(int i = 0; i < Block; ++i)
+		{
+			out[i] -= 1.0f;
+		}
+	}
+};
+
+//short spans are cheaper on the scalar engine than seeding the lanes
+template<typename T>
+static void qRandomFillBlocks(qRandomEngine &engine, T* out, const int count)
+{
+	qRandomLanes lanes(engine);
+	int i = 0;
+	for(; i + qRandomLanes::Block <= count; i += qRandomLanes::Block)
+	{
+		lanes.Next(out + i);
+	}
+	
+	if(i < count)
+	{
+		T tail[qRandomLanes::Block];
+		lanes.Next(tail);
+		for(int k = 0; i < count; ++i, ++k)
+		{
+			out[i] = tail[k];
+		}
+	}
+}
+
+void qRandomFill01(qRandomEngine &engine, float* out, const int count)
+{
+	if(count < qRandomLanes::Block * 4)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			out[i] = engine.NextFloat();
+		}
+		return;
+	}
+	
+	qRandomFillBlocks(engine, out, count);
+}
+
+void qRandomFill(qRandomEngine &engine, float* out, const int count, const float min, const float max)
+{
+	qASSERT(max >= min);
+	qRandomFill01(engine, out, count);
+	
+	const float range = max - min;
+	for(int i = 0; i < count; ++i)
+	{
+		out[i] = min + out[i] * range;
+	}
+}
+
+void qRandomFill(qRandomEngine &engine, int* out, const int count, const int min, const int max)
+{
+	qASSERT(max >= min);
+	static_assert(sizeof(int) == sizeof(uint32_t), "ints are generated in place from random words");
+	
+	uint32_t* bits = reinterpret_cast<uint32_t*>(out);
+	if(count < qRandomLanes::Block * 4)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			bits[i] = engine.Next32();
+		}
+	}
+	else
+	{
+		qRandomFillBlocks(engine, bits, count);
+	}
+	
+	//multiply-shift without rejection, so the bias is at most range / 2^32
+	const uint64_t range = uint64_t(int64_t(max) - int64_t(min));
+	for(int i = 0; i < count; ++i)
+	{
+		out[i] = int(int64_t(min) + int64_t((uint64_t(bits[i]) * range) >> 32));
+	}
+}
+
+void qRandomFillGaussian(qRandomEngine &engine, float* out, const int count, const float mean, const float stdDev)
+{
+	const qZiggurat& table = qZiggurat::Get();
+	if(count < qRandomLanes::Block * 4)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			out[i] = mean + stdDev * table.Sample(engine, engine.Next32());
+		}
+		return;
+	}
+	
+	//the lanes supply the words, the table compare runs per value and the few misses fall back to the engine
+	qRandomLanes lanes(engine);
+	uint32_t bits[qRandomLanes::Block];
+	for(int base = 0; base < count; base += qRandomLanes::Block)
+	{
+		lanes.Next(bits);
+		const int block = qMin(int(qRandomLanes::Block), count - base);
+		for(int i = 0; i < block; ++i)
+		{
+			out[base + i] = mean + stdDev * table.Sample(engine, bits[i]);
+		}
+	}
+}
+
+#pragma mark counter
+
+//sixteen Philox blocks side by side; the 32x32 -> 64 multiplies are pmuludq / vmull lanes, so the rounds vectorize
+static void qPhiloxBlocks(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, uint32_t out[4][16])
+{
+	uint32_t c0[16], c1[16], c2[16], c3[16];
+	for(int l = 0; l < 16; ++l)
+	{
+		const uint64_t index = firstIndex + uint64_t(l);
+		c0[l] = uint32_t(index);
+		c1[l] = uint32_t(index >> 32);
+		c2[l] = uint32_t(stream);
+		c3[l] = uint32_t(stream >> 32);
+	}
+	
+	uint32_t k0 = counter.key[0];
+	uint32_t k1 = counter.key[1];
+	for(int r = 0; r < qRandomCounter::Rounds; ++r)
+	{
+		for(int l = 0; l < 16; ++l)
+		{
+			const uint64_t p0 = uint64_t(qRandomCounter::M0) * c0[l];
+			const uint64_t p1 = uint64_t(qRandomCounter::M1) * c2[l];
+			c0[l] = uint32_t(p1 >> 32) ^ c1[l] ^ k0;
+			c2[l] = uint32_t(p0 >> 32) ^ c3[l] ^ k1;
+			c1[l] = uint32_t(p1);
+			c3[l] = uint32_t(p0);
+		}
+		k0 += qRandomCounter::W0;
+		k1 += qRandomCounter::W1;
+	}
+	
+	memcpy(out[0], c0, sizeof(c0));
+	memcpy(out[1], c1, sizeof(c1));
+	memcpy(out[2], c2, sizeof(c2));
+	memcpy(out[3], c3, sizeof(c3));
+}
+
+//scalar order: each run of sixteen blocks is sixty four indices, word k of lane l holding index 16 * k + l
+template<typename T, typename CONVERT>
+static void qPhiloxFill(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, T* out, const int count, CONVERT convert)
+{
+	uint32_t words[4][16];
+	T values[64];
+	uint64_t block = (firstIndex >> 6) << 4;
+	int skip = int(firstIndex & 63);
+	for(int i = 0; i < count; block += 16)
+	{
+		qPhiloxBlocks(counter, stream, block, words);
+		const uint32_t* flat = words[0];
+		for(int j = 0; j < 64; ++j)
+		{
+			values[j] = convert(flat[j]);
+		}
+		
+		const int n = qMin(64 - skip, count - i);
+		memcpy(out + i, values + skip, n * sizeof(T));
+		i += n;
+		skip = 0;
+	}
+}
+
+//one block per index in the component layout, word k to component k
+template<int N>
+static void qPhiloxFillComponents(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, float* out, const int count)
+{
+	uint32_t words[4][16];
+	float values[16 * N];
+	for(int base = 0; base < count; base += 16)
+	{
+		qPhiloxBlocks(counter, stream, qRandomCounter::ComponentBlocks | (firstIndex + uint64_t(base)), words);
+		for(int i = 0; i < 16; ++i)
+		{
+			for(int k = 0; k < N; ++k)
+			{
+				values[i * N + k] = qRandomCounter::ToFloat(words[k][i]);
+			}
+		}
+		
+		const int block = qMin(16, count - base);
+		memcpy(out + base * N, values, block * N * sizeof(float));
+	}
+}
+
+void qRandomFill01(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, float* out, const int count, const int components)
+{
+	qASSERT(components >= 1 && components <= 4);
+	
+	if(components == 1)
+	{
+		qPhiloxFill(counter, stream, firstIndex, out, count, qRandomCounter::ToFloat);
+		return;
+	}
+	
+	qASSERT(firstIndex + uint64_t(count) <= qRandomCounter::PickBlocks);
+	switch(components)
+	{
+		case 2: qPhiloxFillComponents<2>(counter, stream, firstIndex, out, count); break;
+		case 3: qPhiloxFillComponents<3>(counter, stream, firstIndex, out, count); break;
+		case 4: qPhiloxFillComponents<4>(counter, stream, firstIndex, out, count); break;
+	}
+}
+
+void qRandomFill(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, float* out, const int count, const float min, const float max)
+{
+	qASSERT(max >= min);
+	qRandomFill01(counter, stream, firstIndex, out, count);
+	
+	const float range = max - min;
+	for(int i = 0; i < count; ++i)
+	{
+		out[i] = min + range * out[i];
+	}
+}
+
+void qRandomFill(const qRandomCounter &counter, const uint64_t stream, const uint64_t firstIndex, int* out, const int count, const int min, const int max)
+{
+	qASSERT(max >= min);
+	
+	const int64_t offset = min;
+	const uint64_t range = uint64_t(int64_t(max) - int64_t(min));
+	qPhiloxFill(counter, stream, firstIndex, out, count, [offset, range](const uint32_t word)
+	{
+		return int(offset + int64_t((uint64_t(word) * range) >> 32));
+	});
+}
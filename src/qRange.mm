@@ -21,6 +21,56 @@ SOFTWARE.
 */
 
 #include "qRange.h"
+#include <vector>
+
+//the optional third entry of a range array names the sample mode; a curve follows it with an array of density samples
+template<typename T>
+static void qParseSampleMode(NSArray* rangeArray, qRange<T> &result)
+{
+	if (rangeArray.count > 2)
+	{
+		NSString* modeString = rangeArray[2];
+		if ([modeString isEqualToString:@"uniform"])
+		{
+			result.sampleMode = qRange<T>::eSampleMode_Uniform;
+		}
+		else if ([modeString isEqualToString:@"gaussian"])
+		{
+			result.sampleMode = qRange<T>::eSampleMode_Gaussian;
+		}
+		else if ([modeString isEqualToString:@"truncatedGaussian"])
+		{
+			result.sampleMode = qRange<T>::eSampleMode_TruncatedGaussian;
+		}
+		else if ([modeString isEqualToString:@"exponential"])
+		{
+			result.sampleMode = qRange<T>::eSampleMode_Exponential;
+		}
+		else if ([modeString isEqualToString:@"triangular"])
+		{
+			result.sampleMode = qRange<T>::eSampleMode_Triangular;
+		}
+		else if ([modeString isEqualToString:@"logNormal"])
+		{
+			result.sampleMode = qRange<T>::eSampleMode_LogNormal;
+		}
+		else if ([modeString isEqualToString:@"curve"] && rangeArray.count > 3)
+		{
+			NSArray* curveArray = rangeArray[3];
+			std::vector<float> density;
+			for (NSNumber* sample in curveArray)
+			{
+				density.push_back(sample.floatValue);
+			}
+			result.sampleMode = qRange<T>::eSampleMode_Curve;
+			result.curve = qInverseCDF::Intern(density.data(), int(density.size()));
+		}
+		else
+		{
+			qBREAK("Unknown sample mode %s", [modeString cStringUsingEncoding:NSUTF8StringEncoding]);
+		}
+	}
+}
 
 qRangeF qJSON::RangeF(NSDictionary* JSON, NSString* key, qRangeF defaultValue)
 {
@@ -38,22 +88,7 @@ qRangeF qJSON::RangeF(NSDictionary* JSON, NSString* key, qRangeF defaultValue)
 		{
 			result.max = highRange.floatValue;
 		}
-		if (rangeArray.count > 2)
-		{
-			NSString* modeString = rangeArray[2];
-			if ([modeString isEqualToString:@"uniform"])
-			{
-				result.sampleMode = qRangeF::eSampleMode_Uniform;
-			}
-			else if ([modeString isEqualToString:@"gaussian"])
-			{
-				result.sampleMode = qRangeF::eSampleMode_Gaussian;
-			}
-			else
-			{
-				qBREAK("Unknown sample mode %s", [modeString cStringUsingEncoding:NSUTF8StringEncoding]);
-			}
-		}
+		qParseSampleMode(rangeArray, result);
 	}
 	return result;
 }
@@ -74,22 +109,7 @@ qRangeI qJSON::RangeI(NSDictionary* JSON, NSString* key, qRangeI defaultValue)
 		{
 			result.max = highRange.intValue;
 		}
-		if (rangeArray.count > 2)
-		{
-			NSString* modeString = rangeArray[2];
-			if ([modeString isEqualToString:@"uniform"])
-			{
-				result.sampleMode = qRangeI::eSampleMode_Uniform;
-			}
-			else if ([modeString isEqualToString:@"gaussian"])
-			{
-				result.sampleMode = qRangeI::eSampleMode_Gaussian;
-			}
-			else
-			{
-				qBREAK("Unknown sample mode %s", [modeString cStringUsingEncoding:NSUTF8StringEncoding]);
-			}
-		}
+		qParseSampleMode(rangeArray, result);
 	}
 	return result;
 }
@@ -107,22 +127,7 @@ qRangeF qJSON::RangeF(NSArray* rangeArray, qRangeF defaultValue)
 	{
 		result.max = highRange.floatValue;
 	}
-	if (rangeArray.count > 2)
-	{
-		NSString* modeString = rangeArray[2];
-		if ([modeString isEqualToString:@"uniform"])
-		{
-			result.sampleMode = qRangeF::eSampleMode_Uniform;
-		}
-		else if ([modeString isEqualToString:@"gaussian"])
-		{
-			result.sampleMode = qRangeF::eSampleMode_Gaussian;
-		}
-		else
-		{
-			qBREAK("Unknown sample mode %s", [modeString cStringUsingEncoding:NSUTF8StringEncoding]);
-		}
-	}
+	qParseSampleMode(rangeArray, result);
 	return result;
 }
 
@@ -139,21 +144,6 @@ qRangeI qJSON::RangeI(NSArray* rangeArray, qRangeI defaultValue)
 	{
 		result.max = highRange.intValue;
 	}
-	if (rangeArray.count > 2)
-	{
-		NSString* modeString = rangeArray[2];
-		if ([modeString isEqualToString:@"uniform"])
-		{
-			result.sampleMode = qRangeI::eSampleMode_Uniform;
-		}
-		else if ([modeString isEqualToString:@"gaussian"])
-		{
-			result.sampleMode = qRangeI::eSampleMode_Gaussian;
-		}
-		else
-		{
-			qBREAK("Unknown sample mode %s", [modeString cStringUsingEncoding:NSUTF8StringEncoding]);
-		}
-	}
+	qParseSampleMode(rangeArray, result);
 	return result;
 }
@@ -0,0 +1,134 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "qRangeSampler.h"
+#include "qCore.h"
+#include <algorithm>
+
+static const int kRangeSamplerChunk = 256;
+
+int qRangeSampler::Add(const qRangeF &range)
+{
+	qASSERT(range.max >= range.min);
+	floats[TableFor(range)].Add(floatCount, range);
+	return floatCount++;
+}
+
+int qRangeSampler::Add(const qRangeI &range)
+{
+	qASSERT(range.max >= range.min);
+	ints[TableFor(range)].Add(intCount, range);
+	return intCount++;
+}
+
+//[0, 1) shaped like RandomInRange's gaussian and table driven modes
+static void qRangeSamplerFillUnit(qRandomEngine &engine, const qInverseCDF* shape, const bool gaussian, float* out, const int count)
+{
+	if(shape != nullptr)
+	{
+		shape->Fill(engine, out, count);
+	}
+	else if(gaussian)
+	{
+		//the under 0.1% of draws outside are redrawn one at a time, as RandomInRange does
+		qRandomFillGaussian(engine, out, count, 0.5f, 0.15f);
+		for(int i = 0; i < count; ++i)
+		{
+			while(out[i] < 0.0f || out[i] >= 1.0f)
+			{
+				out[i] = qRandomGaussian(engine, 0.5f, 0.15f);
+			}
+		}
+	}
+	else
+	{
+		static const qTruncatedGaussian shape(0.5f, 0.15f, 0.0f, 1.0f);
+		shape.Fill(engine, out, count);
+	}
+}
+
+void qRangeSampler::Sample(qRandomEngine &engine, const int count, float* const* floatColumns, int* const* intColumns) const
+{
+	qASSERT(count >= 0);
+	
+	const Fields<float> &constFloats = floats[eTable_Constant];
+	for(int f = 0; f < constFloats.Count(); ++f)
+	{
+		std::fill(floatColumns[constFloats.column[f]], floatColumns[constFloats.column[f]] + count, constFloats.min[f]);
+	}
+	
+	const Fields<float> &uniformFloats = floats[eTable_Uniform];
+	for(int f = 0; f < uniformFloats.Count(); ++f)
+	{
+		qRandomFill(engine, floatColumns[uniformFloats.column[f]], count, uniformFloats.min[f], uniformFloats.max[f]);
+	}
+	
+	for(int table = eTable_Gaussian; table <= eTable_Shaped; ++table)
+	{
+		const Fields<float> &fields = floats[table];
+		for(int f = 0; f < fields.Count(); ++f)
+		{
+			float* out = floatColumns[fields.column[f]];
+			const float min = fields.min[f];
+			const float range = fields.max[f] - min;
+			qRangeSamplerFillUnit(engine, fields.shape[f], table == eTable_Gaussian, out, count);
+			for(int i = 0; i < count; ++i)
+			{
+				out[i] = min + range * out[i];
+			}
+		}
+	}
+	
+	const Fields<int> &constInts = ints[eTable_Constant];
+	for(int f = 0; f < constInts.Count(); ++f)
+	{
+		std::fill(intColumns[constInts.column[f]], intColumns[constInts.column[f]] + count, constInts.min[f]);
+	}
+	
+	const Fields<int> &uniformInts = ints[eTable_Uniform];
+	for(int f = 0; f < uniformInts.Count(); ++f)
+	{
+		qRandomFill(engine, intColumns[uniformInts.column[f]], count, uniformInts.min[f], uniformInts.max[f]);
+	}
+	
+	//int columns can't hold the unit draws, so those go through a chunk of scratch
+	float unit[kRangeSamplerChunk];
+	for(int table = eTable_Gaussian; table <= eTable_Shaped; ++table)
+	{
+		const Fields<int> &fields = ints[table];
+		for(int f = 0; f < fields.Count(); ++f)
+		{
+			int* out = intColumns[fields.column[f]];
+			const int min = fields.min[f];
+			const float range = float(fields.max[f] - min);
+			for(int base = 0; base < count; base += kRangeSamplerChunk)
+			{
+				const int elements = qMin(kRangeSamplerChunk, count - base);
+				qRangeSamplerFillUnit(engine, fields.shape[f], table == eTable_Gaussian, unit, elements);
+				for(int i = 0; i < elements; ++i)
+				{
+					out[base + i] = min + int(range * unit[i]);
+				}
+			}
+		}
+	}
+}
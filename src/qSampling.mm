@@ -0,0 +1,240 @@
+/*
+Copyright (c) 2019 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "qSampling.h"
+#include "qRandom.h"
+
+#pragma mark scalar
+
+qVector3 qRandomOnSphere(qRandomEngine &engine)
+{
+	const float u1 = engine.NextFloat();
+	const float u2 = engine.NextFloat();
+	return qSquareToSphere(qVector2(u1, u2));
+}
+
+qVector3 qRandomInBall(qRandomEngine &engine)
+{
+	float u[5];
+	for(int k = 0; k < 5; ++k)
+	{
+		u[k] = engine.NextFloat();
+	}
+	qVector3 result;
+	qSampleKernel<float>::Ball(u[0], u[1], u[2], u[3], u[4], result.x, result.y, result.z);
+	return result;
+}
+
+qVector2 qRandomInDisk(qRandomEngine &engine)
+{
+	const float u1 = engine.NextFloat();
+	const float u2 = engine.NextFloat();
+	return qSquareToDisk(qVector2(u1, u2));
+}
+
+qVector3 qRandomCosineHemisphere(qRandomEngine &engine, const qVector3 &normal)
+{
+	const float u1 = engine.NextFloat();
+	const float u2 = engine.NextFloat();
+	return qSquareToCosineHemisphere(qVector2(u1, u2), normal);
+}
+
+qVector3 qRandomInCone(qRandomEngine &engine, const qVector3 &axis, const float cosHalfAngle)
+{
+	const float u1 = engine.NextFloat();
+	const float u2 = engine.NextFloat();
+	return qSquareToCone(qVector2(u1, u2), axis, cosHalfAngle);
+}
+
+qVector3 qRandomOnTriangle(qRandomEngine &engine, const qTriangle3 &tri)
+{
+	const float u1 = engine.NextFloat();
+	const float u2 = engine.NextFloat();
+	return qSquareToTriangle(qVector2(u1, u2), tri);
+}
+
+//the share of the quad's area in triangle a b c; the rest is a c d
+static float qQuadSplit(const qQuad3 &quad)
+{
+	const float abc = qVector3::Cross(quad.b - quad.a, quad.c - quad.a).Length();
+	const float acd = qVector3::Cross(quad.c - quad.a, quad.d - quad.a).Length();
+	return abc / qMax(abc + acd, 1e-30f);
+}
+
+qVector3 qRandomOnQuad(qRandomEngine &engine, const qQuad3 &quad)
+{
+	const float split = qQuadSplit(quad);
+	const float u1 = engine.NextFloat();
+	const float u2 = engine.NextFloat();
+	const bool first = engine.NextFloat() < split;
+	
+	float wa, wb, wc;
+	qSampleKernel<float>::Triangle(u1, u2, wa, wb, wc);
+	const qVector3 b = first ? quad.b : quad.c;
+	const qVector3 c = first ? quad.c : quad.d;
+	return quad.a * wa + b * wb + c * wc;
+}
+
+#pragma mark fills
+
+//K uniforms per point are drawn a chunk at a time as K planes, then mapped a packet at a time
+static const int qSampleChunk = 256;
+
+template<int K, typename MAP>
+static void qSampleFill(qRandomEngine &engine, qVector3* out, const int count, MAP map)
+{
+	typedef qFloatxN F;
+	const int W = qPACKET_WIDTH;
+	
+	float u[K][qSampleChunk];
+	for(int base = 0; base < count; base += qSampleChunk)
+	{
+		const int n = qMin(qSampleChunk, count - base);
+		qRandomFill01(engine, u[0], K * qSampleChunk);
+		for(int i = 0; i < n; i += W)
+		{
+			F lanes[K];
+			for(int k = 0; k < K; ++k)
+			{
+				lanes[k] = F::Load(u[k] + i);
+			}
+			
+			qVector3x_T<W> v;
+			map(lanes, v.x, v.y, v.z);
+			if(i + W <= n)
+			{
+				v.Store(out + base + i);
+			}
+			else
+			{
+				qVector3 tail[W];
+				v.Store(tail);
+				for(int j = 0; i + j < n; ++j)
+				{
+					out[base + i + j] = tail[j];
+				}
+			}
+		}
+	}
+}
+
+//lanes of a local +z frame rotated onto the basis around n
+static void qSampleToWorld(const qVector3 &t, const qVector3 &b, const qVector3 &n, qFloatxN &x, qFloatxN &y, qFloatxN &z)
+{
+	const qFloatxN lx = x;
+	const qFloatxN ly = y;
+	const qFloatxN lz = z;
+	x = qFloatxN(t.x) * lx + qFloatxN(b.x) * ly + qFloatxN(n.x) * lz;
+	y = qFloatxN(t.y) * lx + qFloatxN(b.y) * ly + qFloatxN(n.y) * lz;
+	z = qFloatxN(t.z) * lx + qFloatxN(b.z) * ly + qFloatxN(n.z) * lz;
+}
+
+void qRandomFillOnSphere(qRandomEngine &engine, qVector3* out, const int count)
+{
+	qSampleFill<2>(engine, out, count, [](const qFloatxN* u, qFloatxN &x, qFloatxN &y, qFloatxN &z)
+	{
+		qSampleKernel<qFloatxN>::Sphere(u[0], u[1], x, y, z);
+	});
+}
+
+void qRandomFillInBall(qRandomEngine &engine, qVector3* out, const int count)
+{
+	qSampleFill<5>(engine, out, count, [](const qFloatxN* u, qFloatxN &x, qFloatxN &y, qFloatxN &z)
+	{
+		qSampleKernel<qFloatxN>::Ball(u[0], u[1], u[2], u[3], u[4], x, y, z);
+	});
+}
+
+void qRandomFillCosineHemisphere(qRandomEngine &engine, qVector3* out, const int count, const qVector3 &normal)
+{
+	qVector3 t, b;
+	qOrthonormalBasis(normal, t, b);
+	qSampleFill<2>(engine, out, count, [&](const qFloatxN* u, qFloatxN &x, qFloatxN &y, qFloatxN &z)
+	{
+		qSampleKernel<qFloatxN>::CosineHemisphere(u[0], u[1], x, y, z);
+		qSampleToWorld(t, b, normal, x, y, z);
+	});
+}
+
+void qRandomFillInCone(qRandomEngine &engine, qVector3* out, const int count, const qVector3 &axis, const float cosHalfAngle)
+{
+	qVector3 t, b;
+	qOrthonormalBasis(axis, t, b);
+	qSampleFill<2>(engine, out, count, [&](const qFloatxN* u, qFloatxN &x, qFloatxN &y, qFloatxN &z)
+	{
+		qSampleKernel<qFloatxN>::Cone(u[0], u[1], qFloatxN(cosHalfAngle), x, y, z);
+		qSampleToWorld(t, b, axis, x, y, z);
+	});
+}
+
+void qRandomFillOnTriangle(qRandomEngine &engine, qVector3* out, const int count, const qTriangle3 &tri)
+{
+	qSampleFill<2>(engine, out, count, [&](const qFloatxN* u, qFloatxN &x, qFloatxN &y, qFloatxN &z)
+	{
+		qFloatxN wa, wb, wc;
+		qSampleKernel<qFloatxN>::Triangle(u[0], u[1], wa, wb, wc);
+		x = qFloatxN(tri.a.x) * wa + qFloatxN(tri.b.x) * wb + qFloatxN(tri.c.x) * wc;
+		y = qFloatxN(tri.a.y) * wa + qFloatxN(tri.b.y) * wb + qFloatxN(tri.c.y) * wc;
+		z = qFloatxN(tri.a.z) * wa + qFloatxN(tri.b.z) * wb + qFloatxN(tri.c.z) * wc;
+	});
+}
+
+void qRandomFillOnQuad(qRandomEngine &engine, qVector3* out, const int count, const qQuad3 &quad)
+{
+	const qFloatxN split(qQuadSplit(quad));
+	qSampleFill<3>(engine, out, count, [&](const qFloatxN* u, qFloatxN &x, qFloatxN &y, qFloatxN &z)
+	{
+		qFloatxN wa, wb, wc;
+		qSampleKernel<qFloatxN>::Triangle(u[0], u[1], wa, wb, wc);
+		const qMaskxN first = u[2] < split;
+		x = qFloatxN(quad.a.x) * wa + qFloatxN::Select(first, quad.b.x, quad.c.x) * wb + qFloatxN::Select(first, quad.c.x, quad.d.x) * wc;
+		y = qFloatxN(quad.a.y) * wa + qFloatxN::Select(first, quad.b.y, quad.c.y) * wb + qFloatxN::Select(first, quad.c.y, quad.d.y) * wc;
+		z = qFloatxN(quad.a.z) * wa + qFloatxN::Select(first, quad.b.z, quad.c.z) * wb + qFloatxN::Select(first, quad.c.z, quad.d.z) * wc;
+	});
+}
+
+void qRandomFillInDisk(qRandomEngine &engine, qVector2* out, const int count)
+{
+	typedef qFloatxN F;
+	const int W = qPACKET_WIDTH;
+	
+	float u[2][qSampleChunk];
+	float xs[qSampleChunk];
+	float ys[qSampleChunk];
+	for(int base = 0; base < count; base += qSampleChunk)
+	{
+		const int n = qMin(qSampleChunk, count - base);
+		qRandomFill01(engine, u[0], 2 * qSampleChunk);
+		for(int i = 0; i < n; i += W)
+		{
+			F x, y;
+			qSampleKernel<F>::Disk(F::Load(u[0] + i), F::Load(u[1] + i), x, y);
+			x.Store(xs + i);
+			y.Store(ys + i);
+		}
+		
+		for(int i = 0; i < n; ++i)
+		{
+			out[base + i] = qVector2(xs[i], ys[i]);
+		}
+	}
+}
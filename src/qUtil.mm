@@ -21,7 +21,6 @@ SOFTWARE.
 */
 
 #include "qUtil.h"
-#include <string.h>
 
 unsigned int qPowerOfTwo(unsigned int v)
 {
@@ -40,28 +39,6 @@ bool qIsPowerOfTwo(unsigned int val)
     return ( (val & (val - 1)) == 0);
 }
 
-//public domain from http://www.burtleburtle.net/bob/hash/doobs.html
-qHashType qHash(const char* key, unsigned int len)
-{
-    unsigned int hash, i;
-    for(hash=0, i=0; i<len; ++i)
-    {
-        hash += key[i];
-        hash += (hash << 10);
-        hash ^= (hash >> 6);
-    }
-    hash += (hash << 3);
-    hash ^= (hash >> 11);
-    hash += (hash << 15);
-    return hash;
-} 
-
-qHashType qHash(const char* key)
-{
-    unsigned int length = (unsigned int)strlen(key);
-    return qHash(key, length);
-}
-
 float qFloor(const float a)
 {
     return floorf(a);
@@ -0,0 +1,53 @@
+/*
+Copyright (c) 2022 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//timing for the benchmarks under tests/, which print their numbers rather than pass or fail. see tests/Makefile
+
+#ifndef __Q_BENCH_H__
+#define __Q_BENCH_H__
+
+#include <chrono>
+
+//the best of a few runs of body, in nanoseconds per item; body does items items of work
+template<typename BODY>
+static double qBenchNanoseconds(const double items, const BODY &body)
+{
+	double best = 0.0;
+	for(int run = 0; run < 5; ++run)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		body();
+		const auto end = std::chrono::steady_clock::now();
+		const double ns = std::chrono::duration<double, std::nano>(end - start).count() / items;
+		best = (run == 0 || ns < best) ? ns : best;
+	}
+	return best;
+}
+
+//makes value look used so the optimizer can't drop the work that produced it
+template<typename T>
+static inline void qBenchKeep(const T &value)
+{
+	asm volatile("" : : "r"(&value) : "memory");
+}
+
+#endif // __Q_BENCH_H__
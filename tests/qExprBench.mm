@@ -0,0 +1,101 @@
+/*
+Copyright (c) 2022 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//times the same r * s + a * t - b * u + c chain written with the eager operators and with qLazy, for qVector3,
+//qVector4 and qMatrix4; prints nanoseconds per result. see tests/Makefile
+
+#include "qExpr.h"
+#include "qBench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+static const int kCount = 1024;
+static const int kPasses = 1024;
+
+static const float s = 0.5f;
+static const float t = 0.25f;
+static const float u = 0.125f;
+
+static float qRandomElement()
+{
+	return float(rand()) / float(RAND_MAX) - 0.5f;
+}
+
+template<typename V>
+static void qFillRandom(std::vector<V> &values)
+{
+	for(V &value : values)
+	{
+		for(int e = 0; e < int(qExprTraits<V>::Size); ++e)
+		{
+			qExprTraits<V>::Data(value)[e] = qRandomElement();
+		}
+	}
+}
+
+template<typename V>
+static void qBenchChain(const char* name)
+{
+	std::vector<V> r(kCount), a(kCount), b(kCount), c(kCount);
+	qFillRandom(r);
+	qFillRandom(a);
+	qFillRandom(b);
+	qFillRandom(c);
+	
+	const double items = double(kCount) * double(kPasses);
+	
+	const double eager = qBenchNanoseconds(items, [&]()
+	{
+		for(int pass = 0; pass < kPasses; ++pass)
+		{
+			for(int i = 0; i < kCount; ++i)
+			{
+				r[i] = r[i] * s + a[i] * t - b[i] * u + c[i];
+			}
+			qBenchKeep(r[0]);
+		}
+	});
+	
+	const double lazy = qBenchNanoseconds(items, [&]()
+	{
+		for(int pass = 0; pass < kPasses; ++pass)
+		{
+			for(int i = 0; i < kCount; ++i)
+			{
+				(qLazy(r[i]) * s + qLazy(a[i]) * t - qLazy(b[i]) * u + c[i]).Evaluate(r[i]);
+			}
+			qBenchKeep(r[0]);
+		}
+	});
+	
+	printf("%-8s eager %6.2f ns  lazy %6.2f ns\n", name, eager, lazy);
+}
+
+int main()
+{
+	srand(1);
+	qBenchChain<qVector3>("qVector3");
+	qBenchChain<qVector4>("qVector4");
+	qBenchChain<qMatrix4>("qMatrix4");
+	return 0;
+}
@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2022 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//times qHash64, qHashStream and the one-at-a-time hash qHash used before them, over keys from 4 bytes to 1 MB;
+//prints GB/s. see tests/Makefile
+
+#include "qHash.h"
+#include "qBench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+//bytes hashed per size and run, whatever the key size
+static const size_t kBytes = size_t(16) << 20;
+
+//the old qHash, taking a starting value so each key can depend on the last
+static uint32_t qOneAtATime(const uint8_t* key, const size_t length, uint32_t hash)
+{
+	for(size_t i = 0; i < length; ++i)
+	{
+		hash += key[i];
+		hash += (hash << 10);
+		hash ^= (hash >> 6);
+	}
+	hash += (hash << 3);
+	hash ^= (hash >> 11);
+	hash += (hash << 15);
+	return hash;
+}
+
+int main()
+{
+	const size_t sizes[] = { 4, 16, 64, 256, 1 << 10, 4 << 10, 64 << 10, 1 << 20 };
+	
+	std::vector<uint8_t> buffer(size_t(1) << 20);
+	srand(1);
+	for(uint8_t &byte : buffer)
+	{
+		byte = uint8_t(rand());
+	}
+	
+	printf("%-10s %13s %9s %12s  (GB/s)\n", "bytes", "one-at-a-time", "qHash64", "qHashStream");
+	for(const size_t size : sizes)
+	{
+		const size_t keys = kBytes / size;
+		const double bytes = double(keys * size);
+		const uint8_t* key = buffer.data();
+		
+		//each hash seeds the next, so no call can be hoisted out of the loop
+		const double oneAtATime = qBenchNanoseconds(bytes, [&]()
+		{
+			uint32_t hash = 0;
+			for(size_t k = 0; k < keys; ++k)
+			{
+				hash = qOneAtATime(key, size, hash);
+			}
+			qBenchKeep(hash);
+		});
+		
+		const double hash64 = qBenchNanoseconds(bytes, [&]()
+		{
+			uint64_t hash = 0;
+			for(size_t k = 0; k < keys; ++k)
+			{
+				hash = qHash64(key, size, hash);
+			}
+			qBenchKeep(hash);
+		});
+		
+		const double stream = qBenchNanoseconds(bytes, [&]()
+		{
+			uint64_t hash = 0;
+			for(size_t k = 0; k < keys; ++k)
+			{
+				qHashStream hasher(hash);
+				hasher.Update(key, size);
+				hash = hasher.Finish();
+			}
+			qBenchKeep(hash);
+		});
+		
+		//nanoseconds per byte to bytes per nanosecond, which is GB/s
+		printf("%-10zu %13.2f %9.2f %12.2f\n", size, 1.0 / oneAtATime, 1.0 / hash64, 1.0 / stream);
+	}
+	return 0;
+}
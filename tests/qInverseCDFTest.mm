@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2022 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//draws each qInverseCDF shape and checks the sample mean and variance against moments integrated from its density;
+//exits nonzero if any shape misses. see tests/Makefile
+
+#include "qInverseCDF.h"
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+static const int kSamples = 1 << 20;
+static const int kIntegrationSteps = 1 << 20;
+
+//relative tolerances; a million draws put the mean within about 0.2% and the variance within about 0.5%
+static const double kMeanTolerance = 0.01;
+static const double kVarianceTolerance = 0.02;
+
+//midpoint rule over [0, 1]
+template<typename DENSITY>
+static void qIntegratedMoments(const DENSITY &density, double &mean, double &variance)
+{
+	double area = 0.0;
+	double first = 0.0;
+	double second = 0.0;
+	for(int i = 0; i < kIntegrationSteps; ++i)
+	{
+		const double x = (double(i) + 0.5) / double(kIntegrationSteps);
+		const double p = density(x);
+		area += p;
+		first += p * x;
+		second += p * x * x;
+	}
+	mean = first / area;
+	variance = second / area - mean * mean;
+}
+
+template<typename DENSITY>
+static bool qCheckMoments(const char* name, const qInverseCDF &cdf, const DENSITY &density)
+{
+	double expectedMean, expectedVariance;
+	qIntegratedMoments(density, expectedMean, expectedVariance);
+	
+	qRandomEngine engine(20);
+	std::vector<float> samples(kSamples);
+	cdf.Fill(engine, samples.data(), kSamples);
+	
+	double sum = 0.0;
+	double sumSquares = 0.0;
+	bool inRange = true;
+	for(const float x : samples)
+	{
+		sum += x;
+		sumSquares += double(x) * x;
+		inRange = inRange && x >= 0.0f && x < 1.0f;
+	}
+	const double mean = sum / kSamples;
+	const double variance = sumSquares / kSamples - mean * mean;
+	
+	const double meanError = fabs(mean - expectedMean) / expectedMean;
+	const double varianceError = fabs(variance - expectedVariance) / expectedVariance;
+	const bool pass = inRange && meanError < kMeanTolerance && varianceError < kVarianceTolerance;
+	
+	printf("%s %-12s mean %.5f expected %.5f (%.2f%%), variance %.5f expected %.5f (%.2f%%)%s\n",
+		   pass ? "ok  " : "FAIL", name, mean, expectedMean, meanError * 100.0, variance, expectedVariance, varianceError * 100.0,
+		   inRange ? "" : ", drew outside [0, 1)");
+	return pass;
+}
+
+int main()
+{
+	bool pass = true;
+	
+	pass = qCheckMoments("exponential", qInverseCDF::Exponential(), [](double x) { return exp(-5.0 * x); }) && pass;
+	pass = qCheckMoments("triangular", qInverseCDF::Triangular(), [](double x) { return 1.0 - fabs(2.0 * x - 1.0); }) && pass;
+	pass = qCheckMoments("lognormal", qInverseCDF::LogNormal(), [](double x)
+	{
+		const double z = log(x / 0.25) / 0.5;
+		return exp(-0.5 * z * z) / x;
+	}) && pass;
+	
+	const float bump[] = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f };
+	pass = qCheckMoments("curve", *qInverseCDF::Intern(bump, 5), [](double x) { return fmax(0.0, 1.0 - fabs(4.0 * x - 2.0)); }) && pass;
+	
+	const float valley[] = { 1.0f, 0.0f, 1.0f };
+	pass = qCheckMoments("two peaks", *qInverseCDF::Intern(valley, 3), [](double x) { return fabs(2.0 * x - 1.0); }) && pass;
+	
+	return pass ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+/*
+Copyright (c) 2022 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//times qMatrix4 multiplies and transforms. it is built once as is and once with qMATH_NO_SIMD, so the two lines it
+//prints compare the qSIMD kernels against the scalar ones. see tests/Makefile
+
+#include "qMatrix4.h"
+#include "qVector3.h"
+#include "qVector4.h"
+#include "qBench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+static const int kCount = 4096;
+static const int kPasses = 256;
+
+static float qRandomElement()
+{
+	return float(rand()) / float(RAND_MAX) - 0.5f;
+}
+
+int main()
+{
+	std::vector<qMatrix4> lhs(kCount);
+	std::vector<qMatrix4> rhs(kCount);
+	std::vector<qMatrix4> product(kCount);
+	std::vector<qVector3> points(kCount);
+	std::vector<qVector3> points3(kCount);
+	std::vector<qVector4> points4(kCount);
+	std::vector<qVector4> out4(kCount);
+	
+	srand(1);
+	for(int i = 0; i < kCount; ++i)
+	{
+		for(int e = 0; e < 16; ++e)
+		{
+			lhs[i].m[e] = qRandomElement();
+			rhs[i].m[e] = qRandomElement();
+		}
+		points[i] = qVector3(qRandomElement(), qRandomElement(), qRandomElement());
+		points4[i] = qVector4(qRandomElement(), qRandomElement(), qRandomElement(), 1.0f);
+	}
+	
+	const double items = double(kCount) * double(kPasses);
+	
+	const double multiply = qBenchNanoseconds(items, [&]()
+	{
+		for(int pass = 0; pass < kPasses; ++pass)
+		{
+			for(int i = 0; i < kCount; ++i)
+			{
+				product[i] = lhs[i] * rhs[i];
+			}
+			qBenchKeep(product[0]);
+		}
+	});
+	
+	const double transform = qBenchNanoseconds(items, [&]()
+	{
+		for(int pass = 0; pass < kPasses; ++pass)
+		{
+			for(int i = 0; i < kCount; ++i)
+			{
+				out4[i] = lhs[i] * points4[i];
+			}
+			qBenchKeep(out4[0]);
+		}
+	});
+	
+	const double transformPoints = qBenchNanoseconds(items, [&]()
+	{
+		for(int pass = 0; pass < kPasses; ++pass)
+		{
+			qMatrix4::TransformPoints(lhs[pass], points.data(), points3.data(), int(points.size()));
+			qBenchKeep(points3[0]);
+		}
+	});
+	
+	const double transformHomogeneous = qBenchNanoseconds(items, [&]()
+	{
+		for(int pass = 0; pass < kPasses; ++pass)
+		{
+			qMatrix4::TransformHomogeneous(lhs[pass], points4.data(), out4.data(), int(points4.size()));
+			qBenchKeep(out4[0]);
+		}
+	});
+	
+	printf("%-6s multiply %6.2f ns  transform %6.2f ns  TransformPoints %6.2f ns  TransformHomogeneous %6.2f ns\n",
+		   qSIMD_ENABLED ? "simd" : "scalar", multiply, transform, transformPoints, transformHomogeneous);
+	return 0;
+}
@@ -0,0 +1,81 @@
+/*
+Copyright (c) 2022 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//times qRandomEngine's xoshiro256** against the C library's rand() for raw words, floats in [0, 1) and bounded
+//integers, and qRandomFill01 for bulk floats; prints nanoseconds per value. see tests/Makefile
+
+#include "qRandom.h"
+#include "qRandomEngine.h"
+#include "qBench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+static const int kCount = 4096;
+static const int kPasses = 1024;
+static const uint32_t kBound = 1000;
+
+int main()
+{
+	std::vector<uint32_t> words(kCount);
+	std::vector<float> floats(kCount);
+	qRandomEngine engine(1);
+	srand(1);
+	
+	const double items = double(kCount) * double(kPasses);
+	
+	auto fill = [&](auto &out, auto next)
+	{
+		return qBenchNanoseconds(items, [&]()
+		{
+			for(int pass = 0; pass < kPasses; ++pass)
+			{
+				for(int i = 0; i < kCount; ++i)
+				{
+					out[i] = next();
+				}
+				qBenchKeep(out[0]);
+			}
+		});
+	};
+	
+	const double randWord = fill(words, []() { return uint32_t(rand()); });
+	const double engineWord = fill(words, [&]() { return engine.Next32(); });
+	const double randFloat = fill(floats, []() { return float(rand()) / (float(RAND_MAX) + 1.0f); });
+	const double engineFloat = fill(floats, [&]() { return engine.NextFloat(); });
+	const double randBounded = fill(words, []() { return uint32_t(rand()) % kBound; });
+	const double engineBounded = fill(words, [&]() { return engine.NextBounded(kBound); });
+	
+	const double engineFill = qBenchNanoseconds(items, [&]()
+	{
+		for(int pass = 0; pass < kPasses; ++pass)
+		{
+			qRandomFill01(engine, floats.data(), int(floats.size()));
+			qBenchKeep(floats[0]);
+		}
+	});
+	
+	printf("word     rand() %6.2f ns  qRandomEngine %6.2f ns\n", randWord, engineWord);
+	printf("float    rand() %6.2f ns  qRandomEngine %6.2f ns  qRandomFill01 %6.2f ns\n", randFloat, engineFloat, engineFill);
+	printf("bounded  rand() %6.2f ns  qRandomEngine %6.2f ns\n", randBounded, engineBounded);
+	return 0;
+}
@@ -0,0 +1,69 @@
+/*
+Copyright (c) 2022 Generation Loss Interactive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+//queries whose bounds quantize to the outermost cells, or to NaN's cell, must fall back to scanning the entries rather
+//than walk the cells between them; exits nonzero if any query finds the wrong count. see tests/Makefile
+
+#include "qSpatialHash.h"
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+static bool qCheckCount(const char* name, const std::vector<int> &found, const size_t expected)
+{
+	const bool pass = found.size() == expected;
+	printf("%s %-16s found %zu expected %zu\n", pass ? "ok  " : "FAIL", name, found.size(), expected);
+	return pass;
+}
+
+int main()
+{
+	qSpatialHash<int> grid(0.5f);
+	for(int i = 0; i < 100; ++i)
+	{
+		grid.Insert(qVector3(float(i % 5), float((i / 5) % 5), float(i / 25)), i);
+	}
+	
+	bool pass = true;
+	std::vector<int> found;
+	
+	grid.QueryAABB(qVector3(-HUGE_VALF), qVector3(HUGE_VALF), found);
+	pass = qCheckCount("infinite box", found, 100) && pass;
+	
+	found.clear();
+	grid.QueryAABB(qVector3(-1e19f), qVector3(1e19f), found);
+	pass = qCheckCount("huge box", found, 100) && pass;
+	
+	found.clear();
+	grid.QueryRadius(qVector3(2.0f), HUGE_VALF, found);
+	pass = qCheckCount("infinite radius", found, 100) && pass;
+	
+	found.clear();
+	grid.QueryAABB(qVector3(NAN, -1.0f, -1.0f), qVector3(10.0f), found);
+	pass = qCheckCount("NaN min", found, 0) && pass;
+	
+	found.clear();
+	grid.QueryRadius(qVector3(0.0f), 1.1f, found);
+	pass = qCheckCount("small radius", found, 4) && pass;
+	
+	return pass ? 0 : 1;
+}